@@ -7,6 +7,8 @@
 #pragma once
 #include <KAOS/Imaging/Color.h>
 #include <KAOS/Imaging/Palette.h>
+#include <KAOS/Imaging/ImageView.h>
+#include <KAOS/Common/AlignedAllocator.h>
 #include <vector>
 #include <memory>
 
@@ -14,34 +16,69 @@
 namespace KAOS { namespace Imaging
 {
 
+	struct ColorUsage
+	{
+		Color	color;
+		size_t	count = 0;
+	};
+
+
+	//	RGBA image stored in a single contiguous buffer. Each row starts on
+	//	a RowAlignment byte boundary and rows are GetStride() pixels apart.
 	class ColorImage
 	{
 	public:
 
-		using row_type = std::vector<Color>;
-		using row_list_type = std::vector<row_type>;
+		static const size_t RowAlignment = 32;
+
+		using pixel_type = Color;
+		using view_type = ColorImageView;
+		using buffer_type = std::vector<pixel_type, Common::AlignedAllocator<pixel_type, RowAlignment>>;
+		using histogram_type = std::vector<ColorUsage>;
+
+		enum class PaletteOrder
+		{
+			FirstUse,
+			Frequency
+		};
 
 
 	public:
 
 		ColorImage() = default;
-		ColorImage(size_t width, size_t height, row_list_type rows);
+		ColorImage(size_t width, size_t height);
+		explicit ColorImage(const view_type& view);
 
 		bool operator==(const ColorImage& other) const;
 
 		size_t GetWidth() const;
 		size_t GetHeight() const;
-		const row_list_type& GetRows() const;
-		Palette GeneratePalette() const;
+		size_t GetStride() const;
+
+		pixel_type* GetRow(size_t y);
+		const pixel_type* GetRow(size_t y) const;
+
+		Palette GeneratePalette(PaletteOrder order = PaletteOrder::FirstUse) const;
+
+		//	Counts how often each color is used. The most used colors come
+		//	first and colors used equally often keep the order in which they
+		//	first appear.
+		histogram_type GenerateHistogram() const;
+
+		//	Same as GenerateHistogram() but splits the rows between threads.
+		//	A thread count of zero uses one thread per hardware thread.
+		histogram_type GenerateHistogramParallel(size_t threadCount = 0) const;
 
-		std::shared_ptr<ColorImage> Extract(size_t xPosition, size_t yPosition, size_t width, size_t height) const;
+		view_type GetView() const;
+		view_type Extract(size_t xPosition, size_t yPosition, size_t width, size_t height) const;
 
 
 	protected:
 
-		size_t			m_Width;	//	FIXME: Superfluous, can be pulled from first element of m_Rows
-		size_t			m_Height;	//	FIXME: Superfluous, can be pulled from size of m_Rows
-		row_list_type	m_Rows;
+		size_t			m_Width = 0;
+		size_t			m_Height = 0;
+		size_t			m_Stride = 0;
+		buffer_type		m_Pixels;
 	};
 
 
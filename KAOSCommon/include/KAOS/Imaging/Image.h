@@ -5,6 +5,8 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #pragma once
+#include <KAOS/Imaging/ImageView.h>
+#include <KAOS/Common/AlignedAllocator.h>
 #include <vector>
 #include <string>
 #include <memory>
@@ -14,33 +16,44 @@
 namespace KAOS { namespace Imaging
 {
 
+	//	Indexed image stored in a single contiguous buffer. Each row starts on
+	//	a RowAlignment byte boundary and rows are GetStride() pixels apart.
 	class Image
 	{
 	public:
 
-		using row_type = std::vector<unsigned char>;
-		using row_list_type = std::vector<row_type>;
+		static const size_t RowAlignment = 32;
+
+		using pixel_type = unsigned char;
+		using view_type = ImageView;
+		using buffer_type = std::vector<pixel_type, Common::AlignedAllocator<pixel_type, RowAlignment>>;
 
 
 	public:
 
 		Image() = default;
-		Image(size_t width, size_t height, row_list_type rows);
+		Image(size_t width, size_t height);
+		explicit Image(const view_type& view);
 
 		bool operator==(const Image& other) const;
 
 		size_t GetWidth() const;
 		size_t GetHeight() const;
-		const row_list_type& GetRows() const;
+		size_t GetStride() const;
+
+		pixel_type* GetRow(size_t y);
+		const pixel_type* GetRow(size_t y) const;
 
-		std::shared_ptr<Image> Extract(size_t xPosition, size_t yPosition, size_t width, size_t height) const;
+		view_type GetView() const;
+		view_type Extract(size_t xPosition, size_t yPosition, size_t width, size_t height) const;
 
 
 	protected:
 
-		size_t			m_Width;	//	FIXME: Superfluous, can be pulled from first element of m_Rows
-		size_t			m_Height;	//	FIXME: Superfluous, can be pulled from size of m_Rows
-		row_list_type	m_Rows;
+		size_t			m_Width = 0;
+		size_t			m_Height = 0;
+		size_t			m_Stride = 0;
+		buffer_type		m_Pixels;
 	};
 
 }}
@@ -9,6 +9,7 @@
 #include <KAOS/Imaging/Image.h>
 #include <KAOS/Imaging/ColorImage.h>
 #include <KAOS/Imaging/Palette.h>
+#include <KAOS/Imaging/ColorQuantizer.h>
 #include <optional>
 
 
@@ -32,6 +33,11 @@ namespace KAOS { namespace Imaging
 		KAOS::Imaging::Palette palette);
 	std::optional<std::pair<Image, Palette>> LoadPNGImage(const std::string& filename, const Palette& palette, size_t transparentSlot);
 	std::optional<ColorImage> LoadPNGColorImage(const std::string& filename);
+	std::optional<Image> LoadQuantizedPNGImage(
+		const std::string& filename,
+		const ColorQuantizer& quantizer,
+		ColorQuantizer::Dithering dithering,
+		std::optional<uint8_t> transparentIndex);
 
 }}
 
@@ -0,0 +1,132 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#pragma once
+#include <KAOS/Imaging/Color.h>
+#include <algorithm>
+#include <stdexcept>
+#include <cstddef>
+
+
+namespace KAOS { namespace Imaging
+{
+
+	//	Non-owning view of a rectangular region of pixels. Rows are stride
+	//	pixels apart so a view can reference a sub-rectangle of a larger
+	//	image without copying it. The viewed image must outlive the view.
+	template<class PixelType_>
+	class BasicImageView
+	{
+	public:
+
+		using pixel_type = PixelType_;
+
+
+	public:
+
+		BasicImageView() = default;
+		BasicImageView(const pixel_type* data, size_t width, size_t height, size_t stride)
+			:
+			m_Data(data),
+			m_Width(width),
+			m_Height(height),
+			m_Stride(stride)
+		{}
+
+		bool operator==(const BasicImageView& other) const
+		{
+			if (m_Width != other.m_Width || m_Height != other.m_Height)
+			{
+				return false;
+			}
+
+			for (auto y(0U); y < m_Height; ++y)
+			{
+				const auto row(GetRow(y));
+				if (!std::equal(row, row + m_Width, other.GetRow(y)))
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		bool operator!=(const BasicImageView& other) const
+		{
+			return !(*this == other);
+		}
+
+		size_t GetWidth() const
+		{
+			return m_Width;
+		}
+
+		size_t GetHeight() const
+		{
+			return m_Height;
+		}
+
+		size_t GetStride() const
+		{
+			return m_Stride;
+		}
+
+		const pixel_type* GetRow(size_t y) const
+		{
+			return m_Data + y * m_Stride;
+		}
+
+		BasicImageView Extract(size_t xPosition, size_t yPosition, size_t width, size_t height) const
+		{
+			if (xPosition > m_Width || width > m_Width - xPosition || yPosition > m_Height || height > m_Height - yPosition)
+			{
+				throw std::out_of_range("Extracted region lies outside of the image");
+			}
+
+			return BasicImageView(GetRow(yPosition) + xPosition, width, height, m_Stride);
+		}
+
+
+	private:
+
+		const pixel_type*	m_Data = nullptr;
+		size_t				m_Width = 0;
+		size_t				m_Height = 0;
+		size_t				m_Stride = 0;
+	};
+
+
+	using ImageView = BasicImageView<unsigned char>;
+	using ColorImageView = BasicImageView<Color>;
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
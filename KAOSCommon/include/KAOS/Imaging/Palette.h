@@ -14,13 +14,16 @@
 namespace KAOS { namespace Imaging
 {
 
+	//	Ordered list of colors with a hashed index from color to the position
+	//	of its first occurrence. The index uses open addressing keyed by the
+	//	packed RGBA value of each color so lookups are constant time.
 	class Palette
 	{
 	public:
 
 		using container_type = std::vector<Color>;
 		using value_type = container_type::value_type;
-		using iterator = container_type::iterator;
+		using iterator = container_type::const_iterator;
 		using const_iterator = container_type::const_iterator;
 		using size_type = container_type::size_type;
 
@@ -35,35 +38,49 @@ namespace KAOS { namespace Imaging
 
 		size_type add(const Color& color, bool force = false)
 		{
-			if (!force)
+			if ((m_ColorData.size() + 1) * 2 > m_Index.size())
 			{
-				const auto currentColor(find(m_ColorData.begin(), m_ColorData.end(), color));
-				if (currentColor != m_ColorData.end())
-				{
-					return distance(m_ColorData.begin(), currentColor);
-				}
+				RebuildIndex(m_ColorData.size() + 1);
+			}
+
+			const auto key(color.toPacked());
+			auto& entry(m_Index[FindSlot(key)]);
+			if (entry.index != EmptySlot && !force)
+			{
+				return entry.index;
 			}
 
 			auto index(m_ColorData.size());
 			m_ColorData.emplace_back(color);
+			if (entry.index == EmptySlot)
+			{
+				entry.color = key;
+				entry.index = index;
+			}
+
 			return index;
 		}
 
 		std::optional<size_type> getIndex(const Color& color) const
 		{
-			const auto currentColor(find(m_ColorData.begin(), m_ColorData.end(), color));
-			if (currentColor != m_ColorData.end())
+			if (m_Index.empty())
 			{
-				return distance(m_ColorData.begin(), currentColor);
+				return std::optional<size_type>();
+			}
+
+			const auto& entry(m_Index[FindSlot(color.toPacked())]);
+			if (entry.index != EmptySlot)
+			{
+				return entry.index;
 			}
 
 			return std::optional<size_type>();
 		}
 
-		container_type::value_type& operator[](size_type index)
-		{
-			return m_ColorData[index];
-		}
+		//	Colors can only be replaced through set() so the index stays in
+		//	sync with the color list.
+		void set(size_type index, const Color& color);
+
 		const container_type::value_type& operator[](size_type index) const
 		{
 			return m_ColorData[index];
@@ -75,41 +92,66 @@ namespace KAOS { namespace Imaging
 			return m_ColorData.size();
 		}
 
-		iterator begin()
-		{
-			return m_ColorData.begin();
-		}
-
 		const_iterator begin() const
 		{
 			return m_ColorData.begin();
 		}
 
-		iterator end()
+		const_iterator end() const
 		{
 			return m_ColorData.end();
 		}
 
-		const_iterator end() const
+
+		const value_type& front() const
 		{
-			return m_ColorData.end();
+			return m_ColorData.front();
 		}
 
 
-		value_type& front()
+	protected:
+
+		struct IndexEntry
 		{
-			return m_ColorData.front();
+			uint32_t	color = 0;
+			size_type	index = EmptySlot;
+		};
+
+		using index_type = std::vector<IndexEntry>;
+
+		static constexpr size_type EmptySlot = static_cast<size_type>(-1);
+
+
+	protected:
+
+		//	Returns the slot holding the color or the empty slot where it
+		//	would be inserted.
+		size_type FindSlot(uint32_t color) const
+		{
+			const auto mask(m_Index.size() - 1);
+			auto slot(HashColor(color) & mask);
+			while (m_Index[slot].index != EmptySlot && m_Index[slot].color != color)
+			{
+				slot = (slot + 1) & mask;
+			}
+
+			return slot;
 		}
 
-		const value_type& front() const
+		static size_type HashColor(uint32_t color)
 		{
-			return m_ColorData.front();
+			const auto hash(color * 0x9e3779b1u);
+
+			return hash ^ (hash >> 16);
 		}
 
+		void RebuildIndex(size_type minimumColors);
+
 
 	protected:
 
 		container_type	m_ColorData;
+		index_type		m_Index;
 	};
 
 
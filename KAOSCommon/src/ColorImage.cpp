@@ -5,25 +5,121 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #include <KAOS/Imaging/ColorImage.h>
-#include <fstream>
-#include <iostream>
+#include <unordered_map>
+#include <algorithm>
+#include <future>
+#include <thread>
 
 
 namespace KAOS { namespace Imaging
 {
 
-	ColorImage::ColorImage(size_t width, size_t height, row_list_type rows)
+	namespace
+	{
+		size_t CalculateStride(size_t width)
+		{
+			const auto rowSize((width * sizeof(ColorImage::pixel_type) + ColorImage::RowAlignment - 1) & ~(ColorImage::RowAlignment - 1));
+
+			return rowSize / sizeof(ColorImage::pixel_type);
+		}
+
+
+		struct HistogramEntry
+		{
+			size_t	count = 0;
+			size_t	firstPixel = 0;
+		};
+
+		using histogram_map_type = std::unordered_map<uint32_t, HistogramEntry>;
+		using sorted_histogram_type = std::vector<std::pair<uint32_t, HistogramEntry>>;
+
+
+		void AccumulateHistogram(const ColorImage& image, size_t firstRow, size_t lastRow, histogram_map_type& histogram)
+		{
+			//	Runs of the same color are common so skip the lookup for them
+			HistogramEntry* currentEntry(nullptr);
+			uint32_t currentColor(0);
+			for (auto y(firstRow); y < lastRow; ++y)
+			{
+				const auto row(image.GetRow(y));
+				for (auto x(0U); x < image.GetWidth(); ++x)
+				{
+					const auto color(row[x].toPacked());
+					if (!currentEntry || color != currentColor)
+					{
+						currentColor = color;
+						currentEntry = &histogram.try_emplace(color, HistogramEntry{ 0, y * image.GetWidth() + x }).first->second;
+					}
+
+					++currentEntry->count;
+				}
+			}
+		}
+
+
+		sorted_histogram_type SortHistogram(const histogram_map_type& histogram, ColorImage::PaletteOrder order)
+		{
+			sorted_histogram_type sortedHistogram(histogram.begin(), histogram.end());
+			if (order == ColorImage::PaletteOrder::Frequency)
+			{
+				std::sort(sortedHistogram.begin(), sortedHistogram.end(), [](const auto& lhs, const auto& rhs)
+				{
+					return lhs.second.count != rhs.second.count
+						? lhs.second.count > rhs.second.count
+						: lhs.second.firstPixel < rhs.second.firstPixel;
+				});
+			}
+			else
+			{
+				std::sort(sortedHistogram.begin(), sortedHistogram.end(), [](const auto& lhs, const auto& rhs)
+				{
+					return lhs.second.firstPixel < rhs.second.firstPixel;
+				});
+			}
+
+			return sortedHistogram;
+		}
+
+
+		ColorImage::histogram_type CreateUsageList(const histogram_map_type& histogram)
+		{
+			ColorImage::histogram_type usage;
+			usage.reserve(histogram.size());
+			for (const auto& entry : SortHistogram(histogram, ColorImage::PaletteOrder::Frequency))
+			{
+				usage.push_back(ColorUsage{ Color::fromPacked(entry.first), entry.second.count });
+			}
+
+			return usage;
+		}
+
+	}
+
+
+	ColorImage::ColorImage(size_t width, size_t height)
 		:
 		m_Width(width),
 		m_Height(height),
-		m_Rows(move(rows))
+		m_Stride(CalculateStride(width)),
+		m_Pixels(m_Stride * height)
+	{
+	}
+
+
+	ColorImage::ColorImage(const view_type& view)
+		: ColorImage(view.GetWidth(), view.GetHeight())
 	{
+		for (auto y(0U); y < m_Height; ++y)
+		{
+			const auto row(view.GetRow(y));
+			std::copy(row, row + m_Width, GetRow(y));
+		}
 	}
 
 
 	bool ColorImage::operator==(const ColorImage& other) const
 	{
-		return m_Rows == other.m_Rows;
+		return GetView() == other.GetView();
 	}
 
 
@@ -37,48 +133,110 @@ namespace KAOS { namespace Imaging
 		return m_Height;
 	}
 
-	//	FIXME: UGH!
-	const ColorImage::row_list_type& ColorImage::GetRows() const
+	size_t ColorImage::GetStride() const
+	{
+		return m_Stride;
+	}
+
+
+	ColorImage::pixel_type* ColorImage::GetRow(size_t y)
 	{
-		return m_Rows;
+		return m_Pixels.data() + y * m_Stride;
 	}
 
-	Palette ColorImage::GeneratePalette() const
+	const ColorImage::pixel_type* ColorImage::GetRow(size_t y) const
 	{
-		Palette palette;
-		for (const auto& row : m_Rows)
+		return m_Pixels.data() + y * m_Stride;
+	}
+
+
+	Palette ColorImage::GeneratePalette(PaletteOrder order) const
+	{
+		histogram_map_type histogram;
+		AccumulateHistogram(*this, 0, m_Height, histogram);
+
+		Palette::container_type colors;
+		colors.reserve(histogram.size());
+		for (const auto& entry : SortHistogram(histogram, order))
 		{
-			for (const auto& pixel : row)
-			{
-				palette.add(pixel);
-			}
+			colors.push_back(Color::fromPacked(entry.first));
 		}
 
-		return move(palette);
+		return Palette(move(colors));
 	}
 
-	std::shared_ptr<ColorImage> ColorImage::Extract(
-		size_t xPosition,
-		size_t yPosition,
-		size_t width,
-		size_t height) const
+
+	ColorImage::histogram_type ColorImage::GenerateHistogram() const
+	{
+		histogram_map_type histogram;
+		AccumulateHistogram(*this, 0, m_Height, histogram);
+
+		return CreateUsageList(histogram);
+	}
+
+
+	ColorImage::histogram_type ColorImage::GenerateHistogramParallel(size_t threadCount) const
 	{
-		//	FIXME: Check bounds!
+		if (threadCount == 0)
+		{
+			threadCount = std::max(1U, std::thread::hardware_concurrency());
+		}
 
+		threadCount = std::max<size_t>(1, std::min(threadCount, m_Height));
+		const auto rowsPerThread((m_Height + threadCount - 1) / threadCount);
 
-		row_list_type tileData;
-		for (auto y(0U); y < height; ++y)
+		std::vector<histogram_map_type> partialHistograms(threadCount);
+		std::vector<std::future<void>> jobs;
+		jobs.reserve(threadCount);
+		for (auto i(0U); i < threadCount; ++i)
 		{
-			const auto& row(m_Rows[yPosition + y]);
-			auto start(row.begin());
-			advance(start, xPosition);
-			auto end(start);
-			advance(end, width);
+			const auto firstRow(std::min(m_Height, i * rowsPerThread));
+			const auto lastRow(std::min(m_Height, firstRow + rowsPerThread));
+			auto& partialHistogram(partialHistograms[i]);
+			jobs.emplace_back(std::async(std::launch::async, [this, firstRow, lastRow, &partialHistogram]()
+			{
+				AccumulateHistogram(*this, firstRow, lastRow, partialHistogram);
+			}));
+		}
 
-			tileData.emplace_back(start, end);
+		for (auto& job : jobs)
+		{
+			job.get();
 		}
 
-		return std::make_shared<ColorImage>(width, height, tileData);
+		//	Merge into the first histogram, keeping the earliest first use
+		auto& histogram(partialHistograms.front());
+		for (auto i(1U); i < partialHistograms.size(); ++i)
+		{
+			for (const auto& entry : partialHistograms[i])
+			{
+				const auto result(histogram.try_emplace(entry.first, entry.second));
+				if (!result.second)
+				{
+					auto& mergedEntry(result.first->second);
+					mergedEntry.count += entry.second.count;
+					mergedEntry.firstPixel = std::min(mergedEntry.firstPixel, entry.second.firstPixel);
+				}
+			}
+		}
+
+		return CreateUsageList(histogram);
+	}
+
+
+	ColorImage::view_type ColorImage::GetView() const
+	{
+		return view_type(m_Pixels.data(), m_Width, m_Height, m_Stride);
+	}
+
+
+	ColorImage::view_type ColorImage::Extract(
+		size_t xPosition,
+		size_t yPosition,
+		size_t width,
+		size_t height) const
+	{
+		return GetView().Extract(xPosition, yPosition, width, height);
 	}
 
 }}
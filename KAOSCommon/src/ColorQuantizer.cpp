@@ -0,0 +1,244 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#include <KAOS/Imaging/ColorQuantizer.h>
+#include <KAOS/Imaging/ImageUtils.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+
+namespace KAOS { namespace Imaging
+{
+
+	namespace
+	{
+
+		//	4x4 Bayer matrix
+		const uint8_t OrderedDitherMatrix[16] =
+		{
+			0, 8, 2, 10,
+			12, 4, 14, 6,
+			3, 11, 1, 9,
+			15, 7, 13, 5
+		};
+
+
+		unsigned int GetDistance(const Color& color, int red, int green, int blue)
+		{
+			const auto redDelta(int(color.red) - red);
+			const auto greenDelta(int(color.green) - green);
+			const auto blueDelta(int(color.blue) - blue);
+
+			return redDelta * redDelta + greenDelta * greenDelta + blueDelta * blueDelta;
+		}
+
+
+		uint8_t ClampChannel(int value)
+		{
+			return static_cast<uint8_t>(std::clamp(value, 0, 255));
+		}
+
+
+		unsigned int GetAverageNearestDistance(const Palette& palette)
+		{
+			if (palette.size() < 2)
+			{
+				return 0;
+			}
+
+			auto totalDistance(0.0);
+			for (auto i(0U); i < palette.size(); ++i)
+			{
+				auto nearestDistance(std::numeric_limits<unsigned int>::max());
+				for (auto j(0U); j < palette.size(); ++j)
+				{
+					const auto& other(palette[j]);
+					const auto distance(GetDistance(palette[i], other.red, other.green, other.blue));
+					if (i != j && distance < nearestDistance)
+					{
+						nearestDistance = distance;
+					}
+				}
+
+				totalDistance += std::sqrt(static_cast<double>(nearestDistance));
+			}
+
+			return static_cast<unsigned int>(std::lround(totalDistance / palette.size()));
+		}
+
+	}
+
+
+	ColorQuantizer::ColorQuantizer(Palette palette)
+		: ColorQuantizer(palette, GetAverageNearestDistance(palette))
+	{
+	}
+
+
+	ColorQuantizer::ColorQuantizer(Palette palette, unsigned int ditherSpread)
+		:
+		m_Palette(move(palette)),
+		m_Table(size_t(1) << (TableBits * 3))
+	{
+		if (m_Palette.size() == 0 || m_Palette.size() > 256)
+		{
+			throw std::invalid_argument("Quantizer palettes must contain between 1 and 256 colors");
+		}
+
+		const auto shift(8 - TableBits);
+		for (auto value(0U); value < 256; ++value)
+		{
+			m_ChannelCells[value] = static_cast<uint8_t>(value >> shift);
+		}
+
+		//	Each table cell holds the palette entry nearest to its center
+		const auto cellSize(1 << shift);
+		const auto cellCount(1 << TableBits);
+		for (auto red(0); red < cellCount; ++red)
+		{
+			for (auto green(0); green < cellCount; ++green)
+			{
+				for (auto blue(0); blue < cellCount; ++blue)
+				{
+					const auto redCenter(red * cellSize + cellSize / 2);
+					const auto greenCenter(green * cellSize + cellSize / 2);
+					const auto blueCenter(blue * cellSize + cellSize / 2);
+
+					size_t nearestIndex(0);
+					auto nearestDistance(std::numeric_limits<unsigned int>::max());
+					for (auto i(0U); i < m_Palette.size(); ++i)
+					{
+						const auto distance(GetDistance(m_Palette[i], redCenter, greenCenter, blueCenter));
+						if (distance < nearestDistance)
+						{
+							nearestDistance = distance;
+							nearestIndex = i;
+						}
+					}
+
+					m_Table[GetTableIndex(redCenter, greenCenter, blueCenter)] = static_cast<uint8_t>(nearestIndex);
+				}
+			}
+		}
+
+		//	Center the dither pattern on zero
+		for (auto i(0U); i < 16; ++i)
+		{
+			m_DitherOffsets[i] = static_cast<int>((OrderedDitherMatrix[i] * 2 + 1) * ditherSpread / 32) - static_cast<int>(ditherSpread / 2);
+		}
+	}
+
+
+	ColorQuantizer ColorQuantizer::CreateForCoCo3RGB()
+	{
+		//	Each channel has two bits, the high bits live in bits 5-3 and the
+		//	low bits in bits 2-0 of the RRGGBB value.
+		static const uint8_t Levels[4] = { 0, 85, 170, 255 };
+
+		Palette::container_type colors;
+		for (auto value(0U); value < 64; ++value)
+		{
+			const auto red(((value >> 4) & 2) | ((value >> 2) & 1));
+			const auto green(((value >> 3) & 2) | ((value >> 1) & 1));
+			const auto blue(((value >> 2) & 2) | (value & 1));
+
+			colors.emplace_back(Levels[red], Levels[green], Levels[blue]);
+		}
+
+		ColorQuantizer quantizer(Palette(move(colors)), 85);
+
+		//	Nearest level matching splits channels at the midpoints between
+		//	levels while ConvertColorToRGBRGB uses its own thresholds. Send
+		//	every channel value to the cell holding the level the converter
+		//	picks so both produce the same RRGGBB values.
+		for (auto value(0U); value < 256; ++value)
+		{
+			const auto bits(ConvertColorToRGBRGB(Color(0, 0, static_cast<uint8_t>(value))));
+			const auto level(((bits >> 2) & 2) | (bits & 1));
+			quantizer.m_ChannelCells[value] = quantizer.m_ChannelCells[Levels[level]];
+		}
+
+		return quantizer;
+	}
+
+
+	const Palette& ColorQuantizer::GetPalette() const
+	{
+		return m_Palette;
+	}
+
+
+	uint8_t ColorQuantizer::Quantize(const Color& color) const
+	{
+		return m_Table[GetTableIndex(color.red, color.green, color.blue)];
+	}
+
+
+	Image ColorQuantizer::Quantize(
+		const ColorImageView& image,
+		Dithering dithering,
+		std::optional<uint8_t> transparentIndex) const
+	{
+		Image quantizedImage(image.GetWidth(), image.GetHeight());
+		for (auto y(0U); y < image.GetHeight(); ++y)
+		{
+			const auto source(image.GetRow(y));
+			auto output(quantizedImage.GetRow(y));
+			const auto ditherRow(&m_DitherOffsets[(y & 3) * 4]);
+			for (auto x(0U); x < image.GetWidth(); ++x)
+			{
+				const auto& color(source[x]);
+				if (transparentIndex.has_value() && !color.isFullOpaque())
+				{
+					output[x] = *transparentIndex;
+				}
+				else if (dithering == Dithering::Ordered)
+				{
+					const auto offset(ditherRow[x & 3]);
+					output[x] = m_Table[GetTableIndex(
+						ClampChannel(color.red + offset),
+						ClampChannel(color.green + offset),
+						ClampChannel(color.blue + offset))];
+				}
+				else
+				{
+					output[x] = m_Table[GetTableIndex(color.red, color.green, color.blue)];
+				}
+			}
+		}
+
+		return quantizedImage;
+	}
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
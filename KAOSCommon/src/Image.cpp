@@ -5,25 +5,47 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #include <KAOS/Imaging/Image.h>
-#include <fstream>
-#include <iostream>
+#include <algorithm>
 
 
 namespace KAOS { namespace Imaging
 {
 
-	Image::Image(size_t width, size_t height, row_list_type rows)
+	namespace
+	{
+		size_t CalculateStride(size_t width)
+		{
+			const auto rowSize((width * sizeof(Image::pixel_type) + Image::RowAlignment - 1) & ~(Image::RowAlignment - 1));
+
+			return rowSize / sizeof(Image::pixel_type);
+		}
+	}
+
+
+	Image::Image(size_t width, size_t height)
 		:
 		m_Width(width),
 		m_Height(height),
-		m_Rows(move(rows))
+		m_Stride(CalculateStride(width)),
+		m_Pixels(m_Stride * height)
 	{
 	}
 
 
+	Image::Image(const view_type& view)
+		: Image(view.GetWidth(), view.GetHeight())
+	{
+		for (auto y(0U); y < m_Height; ++y)
+		{
+			const auto row(view.GetRow(y));
+			std::copy(row, row + m_Width, GetRow(y));
+		}
+	}
+
+
 	bool Image::operator==(const Image& other) const
 	{
-		return m_Rows == other.m_Rows;
+		return GetView() == other.GetView();
 	}
 
 
@@ -37,35 +59,36 @@ namespace KAOS { namespace Imaging
 		return m_Height;
 	}
 
-	//	FIXME: UGH!
-	const Image::row_list_type& Image::GetRows() const
+	size_t Image::GetStride() const
 	{
-		return m_Rows;
+		return m_Stride;
 	}
 
 
-	std::shared_ptr<Image> Image::Extract(
-		size_t xPosition,
-		size_t yPosition,
-		size_t width,
-		size_t height) const
+	Image::pixel_type* Image::GetRow(size_t y)
 	{
-		//	FIXME: Check bounds!
+		return m_Pixels.data() + y * m_Stride;
+	}
 
+	const Image::pixel_type* Image::GetRow(size_t y) const
+	{
+		return m_Pixels.data() + y * m_Stride;
+	}
 
-		row_list_type tileData;
-		for (auto y(0U); y < height; ++y)
-		{
-			const auto& row(m_Rows[yPosition + y]);
-			auto start(row.begin());
-			advance(start, xPosition);
-			auto end(start);
-			advance(end, width);
 
-			tileData.emplace_back(start, end);
-		}
+	Image::view_type Image::GetView() const
+	{
+		return view_type(m_Pixels.data(), m_Width, m_Height, m_Stride);
+	}
+
 
-		return std::make_shared<Image>(width, height, tileData);
+	Image::view_type Image::Extract(
+		size_t xPosition,
+		size_t yPosition,
+		size_t width,
+		size_t height) const
+	{
+		return GetView().Extract(xPosition, yPosition, width, height);
 	}
 
 }}
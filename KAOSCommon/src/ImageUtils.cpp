@@ -6,11 +6,14 @@
 //	of this file.
 #include <KAOS/Imaging/ImageUtils.h>
 #include <KAOS/Imaging/Palette.h>
+#include <KAOS/Imaging/PixelConversion.h>
 #include <KAOS/Common/Utilities.h>
 #include <loadpng/lodepng.h>
 #include <fstream>
 #include <iostream>
 #include <sstream>
+#include <array>
+#include <algorithm>
 
 
 namespace KAOS { namespace Imaging
@@ -38,6 +41,82 @@ namespace KAOS { namespace Imaging
 			return 0x09;
 		}
 
+
+		//	Decoded PNG pixels. Paletted images can be kept as one palette index
+		//	per pixel along with the PNG palette; everything else is expanded
+		//	to RGBA quads.
+		struct DecodedPNG
+		{
+			unsigned					width = 0;
+			unsigned					height = 0;
+			bool						isIndexed = false;
+			std::vector<unsigned char>	pixels;
+			std::vector<Color>			palette;
+		};
+
+
+		std::optional<DecodedPNG> DecodePNG(const std::string& filename, bool keepIndices)
+		{
+			DecodedPNG image;
+			std::vector<unsigned char> fileData;
+			lodepng::State state;
+			auto error(lodepng::load_file(fileData, filename));
+			if (!error && keepIndices)
+			{
+				error = lodepng_inspect(&image.width, &image.height, &state, fileData.data(), fileData.size());
+				image.isIndexed = !error && state.info_png.color.colortype == LCT_PALETTE;
+			}
+
+			if (!error && image.isIndexed)
+			{
+				//	Skip color conversion and unpack the indices ourselves
+				std::vector<unsigned char> packedPixels;
+				state.decoder.color_convert = 0;
+				error = lodepng::decode(packedPixels, image.width, image.height, state, fileData);
+				if (!error)
+				{
+					const auto& colorMode(state.info_png.color);
+					for (auto i(0U); i < colorMode.palettesize; ++i)
+					{
+						const auto entry(colorMode.palette + i * 4);
+						image.palette.emplace_back(entry[0], entry[1], entry[2], entry[3]);
+					}
+
+					//	Scanlines of images with less than 8 bits per pixel are
+					//	not padded to a byte boundary
+					const auto bitDepth(colorMode.bitdepth);
+					const size_t pixelCount(size_t(image.width) * image.height);
+					if (bitDepth == 8)
+					{
+						image.pixels = move(packedPixels);
+					}
+					else
+					{
+						const auto indexMask((1U << bitDepth) - 1);
+						image.pixels.resize(pixelCount);
+						for (size_t i(0); i < pixelCount; ++i)
+						{
+							const auto bitOffset(i * bitDepth);
+							const auto shift(8 - bitDepth - (bitOffset & 7));
+							image.pixels[i] = (packedPixels[bitOffset >> 3] >> shift) & indexMask;
+						}
+					}
+				}
+			}
+			else if (!error)
+			{
+				error = lodepng::decode(image.pixels, image.width, image.height, fileData);
+			}
+
+			if (error)
+			{
+				std::cerr << "decoder error " << error << ": " << lodepng_error_text(error) << std::endl;
+				return std::optional<DecodedPNG>();
+			}
+
+			return image;
+		}
+
 	}
 
 
@@ -90,17 +169,17 @@ namespace KAOS { namespace Imaging
 		}
 
 
-		Image::row_list_type rows(height, Image::row_type(width));
-		for (auto& row : rows)
+		Image image(width, height);
+		for (auto y(0U); y < height; ++y)
 		{
-			if (!input.read(reinterpret_cast<char*>(&row.front()), row.size()))
+			if (!input.read(reinterpret_cast<char*>(image.GetRow(y)), width))
 			{
 				std::cerr << "Unable to load bitmap file `" << filename << "`\n";
 				return std::optional<Image>();
 			}
 		}
 
-		return Image(width, height, move(rows));
+		return image;
 	}
 
 
@@ -114,152 +193,286 @@ namespace KAOS { namespace Imaging
 		size_t verticalSpacing,
 		KAOS::Imaging::Palette palette)
 	{
-		std::vector<unsigned char> rawImage; //the raw pixels
-		unsigned width;
-		unsigned height;
-		const auto error(lodepng::decode(rawImage, width, height, filename));
-		if (error)
+		auto decodedImage(DecodePNG(filename, true));
+		if (!decodedImage.has_value())
 		{
-			std::cerr << "decoder error " << error << ": " << lodepng_error_text(error) << std::endl;
 			return std::optional<std::pair<Image, Palette>>();
 		}
 
-		Image::row_list_type imageRows; //the raw pixels
-		imageRows.reserve(height);
-		auto dataPtr(rawImage.begin());
-		advance(dataPtr, verticalMargin * width * 4);
+		const auto width(decodedImage->width);
+		const auto height(decodedImage->height);
+		const size_t pixelSize(decodedImage->isIndexed ? 1 : 4);
+
+		//	PNG palette entries are added to the palette the first time they
+		//	are used so colors end up in the same order as for RGBA images.
+		static const int UnmappedIndex = -1;
+		std::array<int, 256> paletteRemap;
+		paletteRemap.fill(UnmappedIndex);
+
+		//	Count the tiles first so the image can be allocated in one go
+		size_t tileColumns(0);
+		for (auto imageX = horizontalMargin; imageX < width - horizontalMargin; imageX += tileWidth + horizontalSpacing)
+		{
+			++tileColumns;
+		}
+
+		size_t tileRows(0);
+		for (auto imageY = verticalMargin; imageY < height - verticalMargin; imageY += tileWidth + verticalSpacing)
+		{
+			++tileRows;
+		}
+
+		if (tileRows == 0)
+		{
+			return {};
+		}
+
+		Image image(tileColumns * tileWidth, tileRows * tileHeight);
+		IndexedPixelConverter converter(palette, std::nullopt);
+		auto outputY(0U);
+		auto dataPtr(decodedImage->pixels.data());
+		dataPtr += verticalMargin * width * pixelSize;
 		for (auto imageY = verticalMargin; imageY < height - verticalMargin; imageY += tileWidth + verticalSpacing)
 		{
-			for (auto tileY = imageY; tileY < imageY + tileHeight; ++tileY)
+			//	Rows of tiles along the bottom edge that fall outside the
+			//	image are left at index 0
+			const auto tileRowEnd(std::min<size_t>(imageY + tileHeight, height));
+			for (auto tileY = imageY; tileY < tileRowEnd; ++tileY)
 			{
 				auto savedDataPtr(dataPtr);
-
-				Image::row_type row;
-				row.reserve(width);
+				auto row(image.GetRow(outputY++));
 
 				//
-				advance(dataPtr, horizontalMargin * 4);
+				dataPtr += horizontalMargin * pixelSize;
 				for (auto imageX = horizontalMargin; imageX < width - horizontalMargin; imageX += tileWidth + horizontalSpacing)
 				{
-					for (auto tileX = imageX; tileX < imageX + tileWidth; ++tileX)
+					//	Tiles along the right edge can extend past the image. Only
+					//	the pixels inside it are read and the rest stay at index 0.
+					const auto tilePixels(std::min<size_t>(tileWidth, width - imageX));
+					if (decodedImage->isIndexed)
 					{
-						const Color color(dataPtr[0], dataPtr[1], dataPtr[2], dataPtr[3]);	//	FIXME: Check bounds
-						advance(dataPtr, 4);
-
-						const auto index(palette.add(color));
-						if (index >= 256)
+						for (auto tileX(0U); tileX < tilePixels; ++tileX)
 						{
-							std::cerr << "Image `" << filename << "` exceeds 256 colors\n";
-							return std::optional<std::pair<Image, Palette>>();
+							const auto pngIndex(dataPtr[tileX]);
+							if (paletteRemap[pngIndex] == UnmappedIndex)
+							{
+								if (pngIndex >= decodedImage->palette.size())
+								{
+									std::cerr << "Image `" << filename << "` contains an invalid palette index\n";
+									return std::optional<std::pair<Image, Palette>>();
+								}
+
+								const auto index(palette.add(decodedImage->palette[pngIndex]));
+								if (index >= 256)
+								{
+									std::cerr << "Image `" << filename << "` exceeds 256 colors\n";
+									return std::optional<std::pair<Image, Palette>>();
+								}
+
+								paletteRemap[pngIndex] = static_cast<int>(index);
+							}
+
+							row[tileX] = static_cast<uint8_t>(paletteRemap[pngIndex]);
+						}
+					}
+					else
+					{
+						for (size_t tileX(0); tileX < tilePixels; )
+						{
+							tileX += converter.Convert(dataPtr + tileX * 4, row + tileX, tilePixels - tileX);
+							if (tileX == tilePixels)
+							{
+								break;
+							}
+
+							//	New color, add it to the palette and let the converter pick it up
+							const auto pixel(dataPtr + tileX * 4);
+							const auto index(palette.add(Color(pixel[0], pixel[1], pixel[2], pixel[3])));
+							if (index >= 256)
+							{
+								std::cerr << "Image `" << filename << "` exceeds 256 colors\n";
+								return std::optional<std::pair<Image, Palette>>();
+							}
+
+							converter.Rebuild();
+							row[tileX++] = static_cast<uint8_t>(index);
 						}
-
-						row.emplace_back(static_cast<uint8_t>(index));
 					}
 
-					advance(dataPtr, horizontalSpacing * 4);
+					row += tileWidth;
+					dataPtr += (tileWidth + horizontalSpacing) * pixelSize;
 				}
 
-				dataPtr = savedDataPtr;
-				advance(dataPtr, width * 4);
-
-				imageRows.emplace_back(move(row));
+				dataPtr = savedDataPtr + width * pixelSize;
 			}
 
-			advance(dataPtr, verticalSpacing * width * 4);
+			dataPtr += verticalSpacing * width * pixelSize;
 		}
 
-		if (imageRows.empty())
-		{
-			return {};
-		}
-
-		width = imageRows[0].size();
-		height = imageRows.size();
-
-		return std::make_pair(Image(width, height, move(imageRows)), std::move(palette));
+		return std::make_pair(std::move(image), std::move(palette));
 	}
 
 
 	std::optional<std::pair<Image, Palette>> LoadPNGImage(const std::string& filename, const Palette& palette, size_t transparentSlot)
 	{
-		std::vector<unsigned char> rawImage; //the raw pixels
-		unsigned width;
-		unsigned height;
-		const auto error(lodepng::decode(rawImage, width, height, filename));
-		if (error)
+		const auto decodedImage(DecodePNG(filename, true));
+		if (!decodedImage.has_value())
 		{
-			std::cerr << "decoder error " << error << ": " << lodepng_error_text(error) << std::endl;
 			return std::optional<std::pair<Image, Palette>>();
 		}
 
-		Image::row_list_type imageRows; //the raw pixels
-		imageRows.reserve(height);
-		auto dataPtr(rawImage.begin());
-		for (auto y = 0U; y < height; ++y)
+		const auto width(decodedImage->width);
+		const auto height(decodedImage->height);
+		const auto& rawImage(decodedImage->pixels);
+
+		Image image(width, height);
+		if (decodedImage->isIndexed)
 		{
-			Image::row_type row;
-			row.reserve(width);
-			for (auto x = 0U; x < width; ++x)
+			//	Map each PNG palette entry once instead of every pixel
+			static const int UnmappedIndex = -1;
+			std::array<int, 256> paletteRemap;
+			paletteRemap.fill(UnmappedIndex);
+			for (auto i(0U); i < decodedImage->palette.size(); ++i)
 			{
-				const Color color(dataPtr[0], dataPtr[1], dataPtr[2], dataPtr[3]);	//	FIXME: Check bounds
-				advance(dataPtr, 4);
-
-				std::optional<size_t> index;
-				if(color.alpha != 0xff)
+				const auto& color(decodedImage->palette[i]);
+				const auto index(color.alpha != 0xff ? transparentSlot : palette.getIndex(color));
+				if (index.has_value())
 				{
-					index = transparentSlot;
+					paletteRemap[i] = static_cast<uint8_t>(*index);
 				}
-				else
+			}
+
+			for (auto y = 0U; y < height; ++y)
+			{
+				const auto source(rawImage.data() + y * width);
+				auto row(image.GetRow(y));
+				for (auto x = 0U; x < width; ++x)
 				{
-					index = palette.getIndex(color);
+					const auto index(paletteRemap[source[x]]);
+					if (index == UnmappedIndex)
+					{
+						std::cerr << "Image `" << filename << "` contains color not in palette\n";
+						return std::optional<std::pair<Image, Palette>>();
+					}
+
+					row[x] = static_cast<uint8_t>(index);
+				}
+			}
+
+			return std::make_pair(std::move(image), palette);
+		}
 
+		const IndexedPixelConverter converter(palette, static_cast<uint8_t>(transparentSlot));
+		for (auto y = 0U; y < height; ++y)
+		{
+			const auto source(rawImage.data() + y * width * 4);
+			auto row(image.GetRow(y));
+			for (auto x = 0U; x < width; )
+			{
+				x += converter.Convert(source + x * 4, row + x, width - x);
+				if (x == width)
+				{
+					break;
 				}
+
+				//	The converter stops at colors it cannot map to an 8 bit index
+				const auto pixel(source + x * 4);
+				const auto index(palette.getIndex(Color(pixel[0], pixel[1], pixel[2], pixel[3])));
 				if (!index.has_value())
 				{
 					std::cerr << "Image `" << filename << "` contains color not in palette\n";
 					return std::optional<std::pair<Image, Palette>>();
 				}
 
-				row.emplace_back(static_cast<uint8_t>(*index));
+				row[x++] = static_cast<uint8_t>(*index);
 			}
-
-			imageRows.emplace_back(move(row));
 		}
 
 
-		return std::make_pair(Image(width, height, move(imageRows)), std::move(palette));
+		return std::make_pair(std::move(image), std::move(palette));
 	}
 
 	std::optional<ColorImage> LoadPNGColorImage(const std::string& filename)
 	{
-		std::vector<unsigned char> rawImage; //the raw pixels
-		unsigned width;
-		unsigned height;
-		const auto error(lodepng::decode(rawImage, width, height, filename));
-		if (error)
+		const auto decodedImage(DecodePNG(filename, false));
+		if (!decodedImage.has_value())
 		{
-			std::cerr << "decoder error " << error << ": " << lodepng_error_text(error) << std::endl;
 			return std::optional<ColorImage>();
 		}
 
-		ColorImage::row_list_type imageRows; //the raw pixels
-		imageRows.reserve(height);
-		auto dataPtr(rawImage.begin());
+		const auto width(decodedImage->width);
+		const auto height(decodedImage->height);
+		ColorImage image(width, height);
 		for (auto y = 0U; y < height; ++y)
 		{
-			ColorImage::row_type row;
-			row.reserve(width);
-			for (auto x = 0U; x < width; ++x)
+			ConvertRGBAToColors(decodedImage->pixels.data() + y * width * 4, image.GetRow(y), width);
+		}
+
+
+		return image;
+	}
+
+
+	//	Loads a true color image and maps every pixel to the quantizer's
+	//	palette so artwork does not need to be authored against it.
+	std::optional<Image> LoadQuantizedPNGImage(
+		const std::string& filename,
+		const ColorQuantizer& quantizer,
+		ColorQuantizer::Dithering dithering,
+		std::optional<uint8_t> transparentIndex)
+	{
+		//	Without dithering every pixel with the same PNG palette index maps
+		//	to the same color so paletted images only need their palette
+		//	quantized.
+		const auto decodedImage(DecodePNG(filename, dithering == ColorQuantizer::Dithering::None));
+		if (!decodedImage.has_value())
+		{
+			return std::optional<Image>();
+		}
+
+		const auto width(decodedImage->width);
+		const auto height(decodedImage->height);
+		if (decodedImage->isIndexed)
+		{
+			static const int UnmappedIndex = -1;
+			std::array<int, 256> paletteRemap;
+			paletteRemap.fill(UnmappedIndex);
+			for (auto i(0U); i < decodedImage->palette.size(); ++i)
+			{
+				const auto& color(decodedImage->palette[i]);
+				paletteRemap[i] = transparentIndex.has_value() && !color.isFullOpaque()
+					? *transparentIndex
+					: quantizer.Quantize(color);
+			}
+
+			Image image(width, height);
+			for (auto y = 0U; y < height; ++y)
 			{
-				row.emplace_back(Color(dataPtr[0], dataPtr[1], dataPtr[2], dataPtr[3]));
-				advance(dataPtr, 4);
+				const auto source(decodedImage->pixels.data() + y * width);
+				auto row(image.GetRow(y));
+				for (auto x = 0U; x < width; ++x)
+				{
+					const auto index(paletteRemap[source[x]]);
+					if (index == UnmappedIndex)
+					{
+						std::cerr << "Image `" << filename << "` contains an invalid palette index\n";
+						return std::optional<Image>();
+					}
+
+					row[x] = static_cast<uint8_t>(index);
+				}
 			}
 
-			imageRows.emplace_back(move(row));
+			return image;
 		}
 
+		ColorImage colorImage(width, height);
+		for (auto y = 0U; y < height; ++y)
+		{
+			ConvertRGBAToColors(decodedImage->pixels.data() + y * width * 4, colorImage.GetRow(y), width);
+		}
 
-		return ColorImage(width, height, move(imageRows));
+		return quantizer.Quantize(colorImage.GetView(), dithering, transparentIndex);
 	}
 
 }}
@@ -0,0 +1,204 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+#include <KAOS/Common/MappedFile.h>
+#include <utility>
+
+
+namespace KAOS { namespace Common
+{
+
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+		:
+		m_Data(std::exchange(other.m_Data, nullptr)),
+		m_Size(std::exchange(other.m_Size, 0))
+	{}
+
+
+	MappedFile::~MappedFile()
+	{
+		Close();
+	}
+
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Close();
+			m_Data = std::exchange(other.m_Data, nullptr);
+			m_Size = std::exchange(other.m_Size, 0);
+		}
+
+		return *this;
+	}
+
+
+
+
+#ifdef _WIN32
+
+	bool MappedFile::Open(const std::string& filepath)
+	{
+		Close();
+
+		const auto file(::CreateFileA(
+			filepath.c_str(),
+			GENERIC_READ,
+			FILE_SHARE_READ,
+			nullptr,
+			OPEN_EXISTING,
+			FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+			nullptr));
+		if (file == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+
+		LARGE_INTEGER fileSize;
+		if (!::GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+		{
+			::CloseHandle(file);
+			return false;
+		}
+
+		const auto mapping(::CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr));
+		::CloseHandle(file);
+		if (!mapping)
+		{
+			return false;
+		}
+
+		const auto view(::MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0));
+		::CloseHandle(mapping);
+		if (!view)
+		{
+			return false;
+		}
+
+		m_Data = static_cast<char*>(view);
+		m_Size = static_cast<size_t>(fileSize.QuadPart);
+
+		return true;
+	}
+
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+		{
+			::UnmapViewOfFile(m_Data);
+		}
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+
+#else
+
+	bool MappedFile::Open(const std::string& filepath)
+	{
+		Close();
+
+		const auto file(::open(filepath.c_str(), O_RDONLY));
+		if (file < 0)
+		{
+			return false;
+		}
+
+		struct stat fileStat;
+		if (::fstat(file, &fileStat) != 0 || fileStat.st_size <= 0)
+		{
+			::close(file);
+			return false;
+		}
+
+		const auto size(static_cast<size_t>(fileStat.st_size));
+		const auto view(::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0));
+		::close(file);
+		if (view == MAP_FAILED)
+		{
+			return false;
+		}
+
+		::madvise(view, size, MADV_SEQUENTIAL);
+
+		m_Data = static_cast<char*>(view);
+		m_Size = size;
+
+		return true;
+	}
+
+
+	void MappedFile::Close()
+	{
+		if (m_Data)
+		{
+			::munmap(m_Data, m_Size);
+		}
+
+		m_Data = nullptr;
+		m_Size = 0;
+	}
+
+#endif
+
+
+
+
+	bool MappedFile::IsOpen() const
+	{
+		return m_Data != nullptr;
+	}
+
+
+	char* MappedFile::data() const
+	{
+		return m_Data;
+	}
+
+
+	size_t MappedFile::size() const
+	{
+		return m_Size;
+	}
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
@@ -5,6 +5,7 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #include <KAOS/Imaging/PackedImage.h>
+#include <KAOS/Imaging/PixelConversion.h>
 #include <iostream>
 
 
@@ -21,10 +22,16 @@ namespace KAOS { namespace Imaging
 		const KAOS::Imaging::ColorImage& image,
 		const KAOS::Imaging::Palette& palette)
 	{
+		//	Packed pixels hold a 4 bit palette index so palettes are limited
+		//	to 16 colors. The converter never produces the index just past
+		//	them, which leaves it free to tag transparent pixels.
+		static const size_t MaxColors = 16;
+		static const uint8_t TransparentIndex = MaxColors;
+
 		std::optional<std::pair<PackedImage, PackedImage>> packedImage;
-		if (palette.size() > 16)
+		if (palette.size() > MaxColors)
 		{
-			std::cerr << "Palette must 16 colors or less\n";
+			std::cerr << "Palette must have " << MaxColors << " colors or less\n";
 			return packedImage;
 		}
 
@@ -34,61 +41,28 @@ namespace KAOS { namespace Imaging
 			return packedImage;
 		}
 
+		const auto width(image.GetWidth());
+		const IndexedPixelConverter converter(palette, TransparentIndex);
+		std::vector<uint8_t> indices(width);
+
 		container_type packedBitmapRows;
 		container_type packedMaslRows;
-		for(const auto& currentRow : image.GetRows())
+		packedBitmapRows.reserve(image.GetHeight());
+		packedMaslRows.reserve(image.GetHeight());
+		for (auto y(0U); y < image.GetHeight(); ++y)
 		{
-			PackedImageRow::row_data_type rowData;
-			PackedImageRow::row_data_type rowMask;
-			for (auto pixel(currentRow.begin()); pixel != currentRow.end(); )
+			const auto row(image.GetRow(y));
+			const auto converted(converter.Convert(reinterpret_cast<const uint8_t*>(row), indices.data(), width));
+			if (converted != width)
 			{
-				const auto highColor(*pixel++);
-				const auto lowColor(*pixel++);
-				uint8_t highPixel, highMask;
-				uint8_t lowPixel, lowMask;
-
-				if (highColor.isFullOpaque())
-				{
-					auto index(palette.getIndex(highColor));
-					if (!index.has_value())
-					{
-						std::cerr << "Color " << highColor.toString() <<" not in palette\n";
-						return packedImage;
-					}
-
-					highMask = 0x00;
-					highPixel = static_cast<uint8_t>(*index) << 4;
-				}
-				else
-				{
-					highMask = 0xf0;
-					highPixel = 0;
-				}
-
-
-				if (lowColor.isFullOpaque())
-				{
-					auto index(palette.getIndex(lowColor));
-					if (!index.has_value())
-					{
-						std::cerr << "Color " << lowColor.toString() <<" not in palette\n";
-						return packedImage;
-					}
-
-					lowMask = 0x00;
-					lowPixel = static_cast<uint8_t>(*index);
-				}
-				else
-				{
-					lowMask = 0x0f;
-					lowPixel = 0;
-				}
-
-
-				rowData.push_back(highPixel | lowPixel);
-				rowMask.push_back(highMask | lowMask);
+				std::cerr << "Color " << row[converted].toString() <<" not in palette\n";
+				return packedImage;
 			}
 
+			PackedImageRow::row_data_type rowData(width / 2);
+			PackedImageRow::row_data_type rowMask(width / 2);
+			PackIndexedNibbles(indices.data(), width, TransparentIndex, rowData.data(), rowMask.data());
+
 			packedBitmapRows.emplace_back(PackedImageRow(std::move(rowData)));
 			packedMaslRows.emplace_back(PackedImageRow(std::move(rowMask)));
 		}
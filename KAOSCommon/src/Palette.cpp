@@ -17,12 +17,46 @@ namespace KAOS { namespace Imaging
 
 	Palette::Palette(size_t colorCount, Color initColor)
 		: m_ColorData(colorCount, initColor)
-	{}
+	{
+		RebuildIndex(m_ColorData.size());
+	}
 
 
 	Palette::Palette(container_type colors)
 		: m_ColorData(move(colors))
-	{}
+	{
+		RebuildIndex(m_ColorData.size());
+	}
+
+
+	void Palette::set(size_type index, const Color& color)
+	{
+		m_ColorData[index] = color;
+		RebuildIndex(m_ColorData.size());
+	}
+
+
+	void Palette::RebuildIndex(size_type minimumColors)
+	{
+		//	Keep the table at most half full so probe sequences stay short
+		size_type capacity(16);
+		while (capacity < minimumColors * 2)
+		{
+			capacity *= 2;
+		}
+
+		m_Index.assign(capacity, IndexEntry());
+		for (auto i(0U); i < m_ColorData.size(); ++i)
+		{
+			const auto key(m_ColorData[i].toPacked());
+			auto& entry(m_Index[FindSlot(key)]);
+			if (entry.index == EmptySlot)
+			{
+				entry.color = key;
+				entry.index = i;
+			}
+		}
+	}
 
 
 
@@ -0,0 +1,442 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#include <KAOS/Imaging/PixelConversion.h>
+#include <type_traits>
+#include <cstring>
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define KAOS_IMAGING_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+#ifdef __GNUC__
+#define KAOS_TARGET(isa) __attribute__((target(isa)))
+#else
+#define KAOS_TARGET(isa)
+#endif
+
+
+namespace KAOS { namespace Imaging
+{
+
+	namespace
+	{
+
+		//	Vector kernels convert whole blocks of pixels and stop at the first
+		//	block containing a color that is not in the palette, leaving the
+		//	remainder to the scalar path.
+		using vector_kernel_type = size_t(*)(
+			const uint32_t* colors,
+			size_t colorCount,
+			int transparentIndex,
+			const uint8_t* rgba,
+			uint8_t* output,
+			size_t count);
+
+		//	Nibble kernels pack as many whole blocks as they can and return
+		//	the number of indices consumed.
+		using nibble_kernel_type = size_t(*)(
+			const uint8_t* indices,
+			size_t count,
+			uint8_t transparentIndex,
+			uint8_t* data,
+			uint8_t* mask);
+
+
+#ifdef KAOS_IMAGING_X86
+
+		bool SupportsSSE2()
+		{
+#if defined(_M_X64)
+			return true;
+#elif defined(_MSC_VER)
+			int info[4];
+			__cpuid(info, 1);
+			return (info[3] & (1 << 26)) != 0;
+#else
+			return __builtin_cpu_supports("sse2");
+#endif
+		}
+
+		bool SupportsAVX2()
+		{
+#ifdef _MSC_VER
+			int info[4];
+			__cpuid(info, 0);
+			if (info[0] < 7)
+			{
+				return false;
+			}
+
+			__cpuid(info, 1);
+			const auto osUsesXSave((info[2] & (1 << 27)) != 0);
+			const auto hasAVX((info[2] & (1 << 28)) != 0);
+			if (!osUsesXSave || !hasAVX || (_xgetbv(0) & 6) != 6)
+			{
+				return false;
+			}
+
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#else
+			return __builtin_cpu_supports("avx2");
+#endif
+		}
+
+
+		KAOS_TARGET("sse2")
+		size_t ConvertSSE2(
+			const uint32_t* colors,
+			size_t colorCount,
+			int transparentIndex,
+			const uint8_t* rgba,
+			uint8_t* output,
+			size_t count)
+		{
+			__m128i paletteColors[IndexedPixelConverter::MaxVectorColors];
+			__m128i paletteIndices[IndexedPixelConverter::MaxVectorColors];
+			for (auto i(0U); i < colorCount; ++i)
+			{
+				paletteColors[i] = _mm_set1_epi32(static_cast<int>(colors[i]));
+				paletteIndices[i] = _mm_set1_epi32(static_cast<int>(i));
+			}
+
+			const auto notFound(_mm_set1_epi32(-1));
+			const auto opaqueAlpha(_mm_set1_epi32(0xff));
+			const auto transparent(_mm_set1_epi32(transparentIndex));
+
+			size_t converted(0);
+			for (; converted + 4 <= count; converted += 4)
+			{
+				const auto pixels(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + converted * 4)));
+
+				//	Walk the palette backwards so the first matching entry wins
+				auto indices(notFound);
+				for (auto i(colorCount); i-- > 0; )
+				{
+					const auto match(_mm_cmpeq_epi32(pixels, paletteColors[i]));
+					indices = _mm_or_si128(_mm_and_si128(match, paletteIndices[i]), _mm_andnot_si128(match, indices));
+				}
+
+				if (transparentIndex >= 0)
+				{
+					const auto isOpaque(_mm_cmpeq_epi32(_mm_srli_epi32(pixels, 24), opaqueAlpha));
+					indices = _mm_or_si128(_mm_and_si128(isOpaque, indices), _mm_andnot_si128(isOpaque, transparent));
+				}
+
+				if (_mm_movemask_epi8(_mm_cmpeq_epi32(indices, notFound)) != 0)
+				{
+					break;
+				}
+
+				const auto packed(_mm_packus_epi16(_mm_packs_epi32(indices, indices), _mm_setzero_si128()));
+				const auto value(_mm_cvtsi128_si32(packed));
+				std::memcpy(output + converted, &value, sizeof(value));
+			}
+
+			return converted;
+		}
+
+
+		KAOS_TARGET("avx2")
+		size_t ConvertAVX2(
+			const uint32_t* colors,
+			size_t colorCount,
+			int transparentIndex,
+			const uint8_t* rgba,
+			uint8_t* output,
+			size_t count)
+		{
+			__m256i paletteColors[IndexedPixelConverter::MaxVectorColors];
+			__m256i paletteIndices[IndexedPixelConverter::MaxVectorColors];
+			for (auto i(0U); i < colorCount; ++i)
+			{
+				paletteColors[i] = _mm256_set1_epi32(static_cast<int>(colors[i]));
+				paletteIndices[i] = _mm256_set1_epi32(static_cast<int>(i));
+			}
+
+			const auto notFound(_mm256_set1_epi32(-1));
+			const auto opaqueAlpha(_mm256_set1_epi32(0xff));
+			const auto transparent(_mm256_set1_epi32(transparentIndex));
+
+			size_t converted(0);
+			for (; converted + 8 <= count; converted += 8)
+			{
+				const auto pixels(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(rgba + converted * 4)));
+
+				//	Walk the palette backwards so the first matching entry wins
+				auto indices(notFound);
+				for (auto i(colorCount); i-- > 0; )
+				{
+					const auto match(_mm256_cmpeq_epi32(pixels, paletteColors[i]));
+					indices = _mm256_blendv_epi8(indices, paletteIndices[i], match);
+				}
+
+				if (transparentIndex >= 0)
+				{
+					const auto isOpaque(_mm256_cmpeq_epi32(_mm256_srli_epi32(pixels, 24), opaqueAlpha));
+					indices = _mm256_blendv_epi8(transparent, indices, isOpaque);
+				}
+
+				if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(indices, notFound)) != 0)
+				{
+					break;
+				}
+
+				const auto words(_mm_packs_epi32(_mm256_castsi256_si128(indices), _mm256_extracti128_si256(indices, 1)));
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(output + converted), _mm_packus_epi16(words, words));
+			}
+
+			return converted;
+		}
+
+
+		KAOS_TARGET("sse2")
+		size_t PackNibblesSSE2(
+			const uint8_t* indices,
+			size_t count,
+			uint8_t transparentIndex,
+			uint8_t* data,
+			uint8_t* mask)
+		{
+			const auto transparent(_mm_set1_epi8(static_cast<char>(transparentIndex)));
+			const auto lowByte(_mm_set1_epi16(0x00ff));
+			const auto maskNibbles(_mm_set1_epi16(0x0ff0));
+
+			size_t packed(0);
+			for (; packed + 16 <= count; packed += 16)
+			{
+				const auto pixels(_mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + packed)));
+				const auto isTransparent(_mm_cmpeq_epi8(pixels, transparent));
+				const auto values(_mm_andnot_si128(isTransparent, pixels));
+
+				//	Each 16 bit lane holds a pixel pair with the left pixel in
+				//	the low byte. Move it to the high nibble and fold the pair.
+				const auto pixelPairs(_mm_or_si128(
+					_mm_slli_epi16(_mm_and_si128(values, lowByte), 4),
+					_mm_srli_epi16(values, 8)));
+				const auto maskBits(_mm_and_si128(isTransparent, maskNibbles));
+				const auto maskPairs(_mm_or_si128(_mm_and_si128(maskBits, lowByte), _mm_srli_epi16(maskBits, 8)));
+
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(data + packed / 2), _mm_packus_epi16(pixelPairs, pixelPairs));
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(mask + packed / 2), _mm_packus_epi16(maskPairs, maskPairs));
+			}
+
+			return packed;
+		}
+
+
+		KAOS_TARGET("avx2")
+		size_t PackNibblesAVX2(
+			const uint8_t* indices,
+			size_t count,
+			uint8_t transparentIndex,
+			uint8_t* data,
+			uint8_t* mask)
+		{
+			const auto transparent(_mm256_set1_epi8(static_cast<char>(transparentIndex)));
+			const auto lowByte(_mm256_set1_epi16(0x00ff));
+			const auto maskNibbles(_mm256_set1_epi16(0x0ff0));
+
+			size_t packed(0);
+			for (; packed + 32 <= count; packed += 32)
+			{
+				const auto pixels(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(indices + packed)));
+				const auto isTransparent(_mm256_cmpeq_epi8(pixels, transparent));
+				const auto values(_mm256_andnot_si256(isTransparent, pixels));
+
+				//	Each 16 bit lane holds a pixel pair with the left pixel in
+				//	the low byte. Move it to the high nibble and fold the pair.
+				const auto pixelPairs(_mm256_or_si256(
+					_mm256_slli_epi16(_mm256_and_si256(values, lowByte), 4),
+					_mm256_srli_epi16(values, 8)));
+				const auto maskBits(_mm256_and_si256(isTransparent, maskNibbles));
+				const auto maskPairs(_mm256_or_si256(_mm256_and_si256(maskBits, lowByte), _mm256_srli_epi16(maskBits, 8)));
+
+				//	Packing works within 128 bit lanes, gather the low quad of each
+				const auto packedPixels(_mm256_permute4x64_epi64(_mm256_packus_epi16(pixelPairs, pixelPairs), 0x08));
+				const auto packedMask(_mm256_permute4x64_epi64(_mm256_packus_epi16(maskPairs, maskPairs), 0x08));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(data + packed / 2), _mm256_castsi256_si128(packedPixels));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(mask + packed / 2), _mm256_castsi256_si128(packedMask));
+			}
+
+			return packed;
+		}
+
+#endif
+
+
+		vector_kernel_type SelectVectorKernel()
+		{
+#ifdef KAOS_IMAGING_X86
+			if (SupportsAVX2())
+			{
+				return ConvertAVX2;
+			}
+
+			if (SupportsSSE2())
+			{
+				return ConvertSSE2;
+			}
+#endif
+
+			return nullptr;
+		}
+
+
+		nibble_kernel_type SelectNibbleKernel()
+		{
+#ifdef KAOS_IMAGING_X86
+			if (SupportsAVX2())
+			{
+				return PackNibblesAVX2;
+			}
+
+			if (SupportsSSE2())
+			{
+				return PackNibblesSSE2;
+			}
+#endif
+
+			return nullptr;
+		}
+
+	}
+
+
+	IndexedPixelConverter::IndexedPixelConverter(const Palette& palette, std::optional<uint8_t> transparentIndex)
+		:
+		m_Palette(&palette),
+		m_TransparentIndex(transparentIndex)
+	{
+		Rebuild();
+	}
+
+
+	void IndexedPixelConverter::Rebuild()
+	{
+		m_VectorColors.clear();
+		if (m_Palette->size() <= MaxVectorColors)
+		{
+			for (const auto& color : *m_Palette)
+			{
+				m_VectorColors.push_back(color.toPacked());
+			}
+		}
+	}
+
+
+	size_t IndexedPixelConverter::Convert(const uint8_t* rgba, uint8_t* output, size_t count) const
+	{
+		static const auto vectorKernel(SelectVectorKernel());
+
+		const auto transparentIndex(m_TransparentIndex.has_value() ? static_cast<int>(*m_TransparentIndex) : -1);
+
+		size_t converted(0);
+		while (converted < count)
+		{
+			if (vectorKernel && !m_VectorColors.empty())
+			{
+				converted += vectorKernel(
+					m_VectorColors.data(),
+					m_VectorColors.size(),
+					transparentIndex,
+					rgba + converted * 4,
+					output + converted,
+					count - converted);
+
+				if (converted == count)
+				{
+					break;
+				}
+			}
+
+			//	Convert a single pixel so the vector kernel can resume past a
+			//	block it was unable to handle.
+			const auto pixel(rgba + converted * 4);
+			if (transparentIndex >= 0 && pixel[3] != 0xff)
+			{
+				output[converted] = static_cast<uint8_t>(transparentIndex);
+			}
+			else
+			{
+				const auto index(m_Palette->getIndex(Color(pixel[0], pixel[1], pixel[2], pixel[3])));
+				if (!index.has_value() || *index > 0xff)
+				{
+					break;
+				}
+
+				output[converted] = static_cast<uint8_t>(*index);
+			}
+
+			++converted;
+		}
+
+		return converted;
+	}
+
+
+	void ConvertRGBAToColors(const uint8_t* rgba, Color* output, size_t count)
+	{
+		//	Color matches the RGBA byte layout so whole rows can be copied
+		static_assert(sizeof(Color) == 4, "Color must be exactly one RGBA quad");
+		static_assert(std::is_trivially_copyable_v<Color>, "Color must be trivially copyable");
+
+		std::memcpy(static_cast<void*>(output), rgba, count * sizeof(Color));
+	}
+
+
+
+	void PackIndexedNibbles(
+		const uint8_t* indices,
+		size_t count,
+		uint8_t transparentIndex,
+		uint8_t* data,
+		uint8_t* mask)
+	{
+		static const auto nibbleKernel(SelectNibbleKernel());
+
+		size_t packed(nibbleKernel ? nibbleKernel(indices, count, transparentIndex, data, mask) : 0);
+		for (; packed + 2 <= count; packed += 2)
+		{
+			const auto high(indices[packed]);
+			const auto low(indices[packed + 1]);
+
+			data[packed / 2] = (high == transparentIndex ? 0 : high << 4) | (low == transparentIndex ? 0 : low);
+			mask[packed / 2] = (high == transparentIndex ? 0xf0 : 0x00) | (low == transparentIndex ? 0x0f : 0x00);
+		}
+	}
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
@@ -19,6 +19,9 @@
 #include <algorithm>
 #include <cctype>
 #include <iostream>
+#include <filesystem>
+#include <unordered_map>
+#include <mutex>
 #include <shlwapi.h>
 
 namespace KAOS { namespace Common
@@ -194,6 +197,44 @@ namespace KAOS { namespace Common
 		return ConvertToLower(extBuffer);
 	}
 
+#ifdef __unix__
+
+	bool IsAbsolutePath(const std::string& path)
+	{
+		return !path.empty() && path[0] == '/';
+	}
+
+
+	std::string EnsureAbsolutePath(const std::string& relativePath)
+	{
+		std::error_code error;
+		const auto absolutePath(std::filesystem::absolute(relativePath, error));
+		if (error)
+		{
+			throw std::runtime_error("Unable to convert relative path to absolute path");
+		}
+
+		return absolutePath.lexically_normal().string();
+	}
+
+
+	std::optional<FileIdentity> QueryFileIdentity(const std::string& path)
+	{
+		struct stat status;
+		if (::stat(path.c_str(), &status) != 0)
+		{
+			return std::optional<FileIdentity>();
+		}
+
+		FileIdentity identity;
+		identity.device = static_cast<uint64_t>(status.st_dev);
+		identity.inode = static_cast<uint64_t>(status.st_ino);
+
+		return identity;
+	}
+
+#else
+
 	bool IsAbsolutePath(const std::string& path)
 	{
 		return !::PathIsRelativeA(path.c_str());
@@ -211,6 +252,43 @@ namespace KAOS { namespace Common
 		return buffer;
 	}
 
+
+	std::optional<FileIdentity> QueryFileIdentity(const std::string& /*path*/)
+	{
+		return std::optional<FileIdentity>();
+	}
+
+#endif
+
+
+	std::string CanonicalizePath(const std::string& path)
+	{
+		static std::mutex mutex;
+		static std::unordered_map<std::string, std::string> canonicalPaths;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			const auto canonicalPath(canonicalPaths.find(path));
+			if (canonicalPath != canonicalPaths.end())
+			{
+				return canonicalPath->second;
+			}
+		}
+
+		//	Paths that do not exist are only normalized
+		std::error_code error;
+		auto canonicalPath(std::filesystem::weakly_canonical(EnsureAbsolutePath(path), error));
+		if (error)
+		{
+			canonicalPath = std::filesystem::path(EnsureAbsolutePath(path));
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+
+		return canonicalPaths.emplace(path, canonicalPath.string()).first->second;
+	}
+
 #undef CreateDirectory
 	bool CreateDirectory(const std::string& path)
 	{
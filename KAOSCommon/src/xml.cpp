@@ -84,6 +84,33 @@ namespace KAOS { namespace Common { namespace XML
 
 
 
+
+	bool MappedDocument::Load(const std::string& filepath, unsigned int options)
+	{
+		m_Document.reset();
+
+		if (!m_File.Open(filepath))
+		{
+			return false;
+		}
+
+		const auto result(m_Document.load_buffer_inplace(m_File.data(), m_File.size(), options));
+		if (!result)
+		{
+			m_Document.reset();
+			m_File.Close();
+			return false;
+		}
+
+		return true;
+	}
+
+
+	const pugi::xml_document& MappedDocument::GetDocument() const
+	{
+		return m_Document;
+	}
+
 }}}
 
 
@@ -22,6 +22,11 @@ namespace Builder
 		m_Configuration(std::move(configuration))
 	{}
 
+	std::optional<DataSource::property_type> DataSource::QueryInternedProperty(const KAOS::Tiled::InternedString& name) const
+	{
+		return QueryProperty(name.str());
+	}
+
 	std::shared_ptr<DataSource::tilesetcache_type> DataSource::QueryTilesetCache() const
 	{
 		return m_TilesetCache;
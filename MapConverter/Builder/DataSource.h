@@ -39,6 +39,9 @@ namespace Builder
 		virtual ~DataSource() = default;
 
 		virtual std::optional<property_type> QueryProperty(const std::string& name) const = 0;
+		//	Queries a property by a name interned once by the caller. Sources
+		//	that can look names up without the string override this.
+		virtual std::optional<property_type> QueryInternedProperty(const KAOS::Tiled::InternedString& name) const;
 		virtual std::shared_ptr<tilesetcache_type> QueryTilesetCache() const;
 		virtual std::shared_ptr<map_type> QueryMap() const;
 		virtual std::shared_ptr<const descriptors_type> QueryDescriptors() const;
@@ -47,7 +47,7 @@ namespace Builder
 
 
 
-	std::shared_ptr<MapDataSource::objectdescriptor_type> MapDataSource::QueryObjectDescriptor(const std::string& /*name*/) const
+	std::shared_ptr<MapDataSource::objectdescriptor_type> MapDataSource::QueryObjectDescriptor(const KAOS::Tiled::InternedString& /*name*/) const
 	{
 		return nullptr;
 	}
@@ -43,7 +43,7 @@ namespace Builder
 
 		std::optional<property_type> QueryProperty(const std::string& name) const override;
 
-		virtual std::shared_ptr<objectdescriptor_type> QueryObjectDescriptor(const std::string& name) const;
+		virtual std::shared_ptr<objectdescriptor_type> QueryObjectDescriptor(const KAOS::Tiled::InternedString& name) const;
 
 		virtual std::shared_ptr<layer_type> QueryLayer(const std::string& name) const;
 		virtual std::shared_ptr<objectlayer_type> QueryObjectLayer(const std::string& name) const;
@@ -69,7 +69,7 @@ namespace Builder
 		{}
 
 
-		std::shared_ptr<objectdescriptor_type> QueryObjectDescriptor(const std::string& name) const override
+		std::shared_ptr<objectdescriptor_type> QueryObjectDescriptor(const KAOS::Tiled::InternedString& name) const override
 		{
 			return m_ObjectSource.Query(name);
 		}
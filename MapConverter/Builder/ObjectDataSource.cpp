@@ -11,7 +11,7 @@ namespace Builder
 {
 
 	ObjectDataSource::ObjectDataSource(
-		const KAOS::Tiled::Object& object,
+		KAOS::Tiled::ObjectGroup::ObjectView object,
 		unsigned long long typeId,
 		std::shared_ptr<map_type> map,
 		std::shared_ptr<tilesetcache_type> tilesetCache,
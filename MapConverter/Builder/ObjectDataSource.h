@@ -6,7 +6,7 @@
 //	of this file.
 #pragma once
 #include "Builder/DataSource.h"
-#include <Tiled/Object.h>
+#include <Tiled/ObjectGroup.h>
 
 
 namespace Builder
@@ -17,7 +17,7 @@ namespace Builder
 	public:
 	
 		ObjectDataSource(
-			const KAOS::Tiled::Object& object,
+			KAOS::Tiled::ObjectGroup::ObjectView object,
 			unsigned long long typeId,
 			std::shared_ptr<map_type> map,
 			std::shared_ptr<tilesetcache_type> tilesetCache,
@@ -30,7 +30,7 @@ namespace Builder
 
 	private:
 
-		const KAOS::Tiled::Object&	m_Object;
+		const KAOS::Tiled::ObjectGroup::ObjectView	m_Object;
 		const unsigned long long	m_TypeId;
 	};
 
@@ -11,20 +11,54 @@ namespace Builder
 {
 
 	TileDataSource::TileDataSource(
-		const KAOS::Tiled::Tile& tile,
+		const KAOS::Tiled::Tileset& tileset,
 		std::shared_ptr<map_type> map,
 		std::shared_ptr<tilesetcache_type> tilesetCache,
 		std::shared_ptr<const descriptors_type> descriptors,
 		Configuration configuration)
 		:
 		DataSource(move(map), move(tilesetCache), move(descriptors), std::move(configuration)),
-		m_Tile(tile)
+		m_Tileset(tileset)
 	{}
 
 
+	void TileDataSource::SetTileId(KAOS::Tiled::Tile::id_type tileId)
+	{
+		m_TileId = tileId;
+	}
+
+
 	std::optional<KAOS::Tiled::PropertyBag::value_type> TileDataSource::QueryProperty(const std::string& name) const
 	{
-		return m_Tile.QueryProperty(name);
+		const auto key(KAOS::Tiled::InternedString::Find(name));
+
+		return key.has_value() ? QueryInternedProperty(*key) : std::optional<property_type>();
+	}
+
+
+	std::optional<KAOS::Tiled::PropertyBag::value_type> TileDataSource::QueryInternedProperty(const KAOS::Tiled::InternedString& name) const
+	{
+		const auto column(FindColumn(name));
+
+		return column ? column->find(m_TileId) : std::optional<property_type>();
+	}
+
+
+	const KAOS::Tiled::TilePropertyColumn* TileDataSource::FindColumn(const KAOS::Tiled::InternedString& name) const
+	{
+		for (const auto& column : m_Columns)
+		{
+			if (column.first == name)
+			{
+				return column.second;
+			}
+		}
+
+		//	Properties no tile defines are remembered as well
+		const auto column(m_Tileset.FindTilePropertyColumn(name));
+		m_Columns.emplace_back(name, column);
+
+		return column;
 	}
 
 }
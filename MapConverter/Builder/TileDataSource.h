@@ -6,30 +6,50 @@
 //	of this file.
 #pragma once
 #include "Builder/DataSource.h"
-#include <Tiled/Tile.h>
+#include <Tiled/Tileset.h>
+#include <vector>
+#include <utility>
 
 
 namespace Builder
 {
 
+	//	Reads tile properties from the columns of a tileset. One source serves
+	//	every tile of the tileset so each descriptor field resolves its column
+	//	once and later tiles only index into it.
 	class TileDataSource : public DataSource
 	{
 	public:
 	
 		explicit TileDataSource(
-			const KAOS::Tiled::Tile& tile,
+			const KAOS::Tiled::Tileset& tileset,
 			std::shared_ptr<map_type> map,
 			std::shared_ptr<tilesetcache_type> tilesetCache,
 			std::shared_ptr<const descriptors_type> descriptors,
 			Configuration configuration);
 
 
+		//	Selects the tile read by following queries
+		void SetTileId(KAOS::Tiled::Tile::id_type tileId);
+
 		std::optional<property_type> QueryProperty(const std::string& name) const override;
+		std::optional<property_type> QueryInternedProperty(const KAOS::Tiled::InternedString& name) const override;
+
+
+	private:
+
+		using column_cache_type = std::vector<std::pair<KAOS::Tiled::InternedString, const KAOS::Tiled::TilePropertyColumn*>>;
+
+		const KAOS::Tiled::TilePropertyColumn* FindColumn(const KAOS::Tiled::InternedString& name) const;
 
 
 	private:
 
-		const KAOS::Tiled::Tile&	m_Tile;
+		const KAOS::Tiled::Tileset&	m_Tileset;
+		KAOS::Tiled::Tile::id_type	m_TileId = 0;
+		//	Descriptors have a handful of fields so a linear scan comparing
+		//	interned names is cheaper than hashing.
+		mutable column_cache_type	m_Columns;
 	};
 
 }
@@ -62,9 +62,9 @@ namespace DescriptorNodes
 		}
 	
 
-		m_TypeName = typenameAttr.as_string();
+		m_TypeName = typename_type(typenameAttr.as_string());
 		m_TypeId = typeidAttr.as_ullong(0ULL);
-		m_BaseTypeName = extendsAttr.as_string();
+		m_BaseTypeName = typename_type(extendsAttr.as_string());
 
 		return true;
 	}
@@ -136,7 +136,7 @@ namespace DescriptorNodes
 
 	bool Object::CompileInstance(databuilder_type& builder, const datasource_type& dataSource, const Configuration& configuration) const
 	{
-		builder.EmitComment("Instance of object type `" + GetTypeName() + "`");
+		builder.EmitComment("Instance of object type `" + GetTypeName().str() + "`");
 
 		if (m_BaseType)
 		{
@@ -7,6 +7,7 @@
 #pragma once
 #include "DescriptorNodes/CompositeNode.h"
 #include "Builder/MapDataSource.h"
+#include <Tiled/InternedString.h>
 
 namespace DescriptorNodes
 {
@@ -18,7 +19,7 @@ namespace DescriptorNodes
 	{
 	public:
 
-		using typename_type = std::string;
+		using typename_type = KAOS::Tiled::InternedString;
 		using typeid_type = uint64_t;
 
 
@@ -81,9 +81,9 @@ namespace DescriptorNodes
 
 
 		bool hasError(false);
-		for (const auto& object : *layer)
+		for (const auto object : *layer)
 		{
-			const auto& objectTypename(object->GetType());
+			const auto& objectTypename(object.GetType());
 			if (objectTypename.empty())
 			{
 				KAOS::Logging::Error("Object does not have a type assigend to it. Unable to generate code.");
@@ -91,7 +91,7 @@ namespace DescriptorNodes
 				continue;
 			}
 
-			const auto objectDescriptorTmp(mapDataSource.QueryObjectDescriptor(object->GetType()));
+			const auto objectDescriptorTmp(mapDataSource.QueryObjectDescriptor(object.GetInternedType()));
 			if (!objectDescriptorTmp)
 			{
 				KAOS::Logging::Error("Unable to find object descriptor `" + objectTypename + "`");
@@ -107,7 +107,7 @@ namespace DescriptorNodes
 			}
 			
 			Builder::ObjectDataSource objectDataSource(
-				*object,
+				object,
 				objectDescriptor->GetTypeId(),
 				dataSource.QueryMap(),
 				dataSource.QueryTilesetCache(),
@@ -62,7 +62,7 @@ namespace DescriptorNodes
 					auto baseType(std::find_if(members->begin(), members->end(), objectCompare));
 					if (baseType == objects.end())
 					{
-						KAOS::Logging::Error("Base object type `" + baseTypeName + "` not found for `" + object->GetTypeName());
+						KAOS::Logging::Error("Base object type `" + baseTypeName.str() + "` not found for `" + object->GetTypeName().str());
 
 						members.reset();
 						return members;
@@ -78,7 +78,7 @@ namespace DescriptorNodes
 	}
 
 
-	std::shared_ptr<Object> Objects::Query(const std::string& name) const
+	std::shared_ptr<Object> Objects::Query(const Object::typename_type& name) const
 	{
 		auto predicate = [&name](const collection_type::value_type& value) -> bool
 		{
@@ -16,7 +16,7 @@ namespace DescriptorNodes
 	{
 	public:
 
-		virtual std::shared_ptr<Object> Query(const std::string& name) const;
+		virtual std::shared_ptr<Object> Query(const Object::typename_type& name) const;
 
 
 	protected:
@@ -5,10 +5,10 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #include "DescriptorNodes/TiledLayer.h"
+#include <Tiled/GidResolver.h>
 #include <KAOS/Common/Logging.h>
 #include <KAOS/Common/xml.h>
 #include <algorithm>
-#include <deque>
 #include <iostream>
 #include <iomanip>
 
@@ -107,44 +107,55 @@ namespace DescriptorNodes
 		const signature_type signature(m_Signature.has_value() ? signature_type(m_Signature.value()) : Signature);
 
 		builder.EmitValue(std::string(), signature, "Block Signature");
-		builder.EmitValue(std::string(), static_cast<Builder::DataBuilder::property_type::quad_type>(layer->size()), "Number of cells");
+
+		const auto layerSize(layer->GetDimensions());
+
+		builder.EmitValue(std::string(), static_cast<Builder::DataBuilder::property_type::quad_type>(layerSize.GetCount()), "Number of cells");
 		builder.EmitComment("");
 
 		const auto emptyCellId(0U);	//	FIXME: This needs to come from somewhere (datasource?)
-		const auto layerSize(layer->GetDimensions());
 
-		//	Build into rows
-		std::deque<Builder::MapDataSource::tilesetlayer_type::cell_type> data(layer->begin(), layer->end());
-		std::vector<rowcontainer_type> mapDataByRow;
-		while (!data.empty())
+		KAOS::Tiled::GidResolver gidResolver;
+		if (!gidResolver.Build(*mapDataSource.QueryMap(), *mapDataSource.QueryTilesetCache()))
 		{
-			auto lineEnd(data.begin());
-			advance(lineEnd, layerSize.GetWidth());
+			return false;
+		}
 
+		//	Tiles are numbered across all tilesets in the order the tilesets
+		//	are emitted by the tileset descriptor.
+		std::vector<cell_type> tileIdOffsets;
+		cell_type nextTileId(0);
+		for (size_t i(0); i < gidResolver.GetTilesetCount(); ++i)
+		{
+			tileIdOffsets.push_back(nextTileId);
+			nextTileId += static_cast<cell_type>(gidResolver.GetTileCount(static_cast<KAOS::Tiled::GidResolver::tileset_index_type>(i)));
+		}
+
+		std::vector<KAOS::Tiled::GidResolver::ResolvedCell> resolvedRow;
+		bool hasFlippedTiles(false);
 
-			rowcontainer_type newRow(data.begin(), lineEnd);
-			for (auto& cell : newRow)
+		//	Convert, compress and emit each row as it is decoded
+		const auto emitRow([&](const cell_type* rowBegin, const cell_type* rowEnd) -> bool
+		{
+			resolvedRow.resize(rowEnd - rowBegin);
+			if (!gidResolver.Resolve(rowBegin, rowEnd, resolvedRow.data()))
 			{
-				cell = (!cell ? emptyCellId : cell - 1);
+				return false;
 			}
 
-			mapDataByRow.emplace_back(move(newRow));
-
-			data.erase(data.begin(), lineEnd);
-		}
+			rowcontainer_type rowData(resolvedRow.size());
+			for (size_t i(0); i < resolvedRow.size(); ++i)
+			{
+				const auto& cell(resolvedRow[i]);
+				rowData[i] = cell.IsEmpty() ? emptyCellId : tileIdOffsets[cell.tilesetIndex] + cell.localId;
+				hasFlippedTiles |= cell.flags != KAOS::Tiled::GidResolver::FlipFlags::None;
+			}
 
-		//	Compress rows
-		if (configuration.compressTileLayers)
-		{
-			for (auto& rowData : mapDataByRow)
+			if (configuration.compressTileLayers)
 			{
-				rowData = compressRowData(rowData);
+				rowData = compressRowData(move(rowData));
 			}
-		}
 
-		//	Generate the data
-		for (const auto& rowData : mapDataByRow)
-		{
 			for (const auto& id : rowData)
 			{
 				//	FIXME: Check for bounds error
@@ -152,6 +163,19 @@ namespace DescriptorNodes
 			}
 
 			builder.Flush();
+
+			return true;
+		});
+
+		if (!layer->VisitRows(emitRow))
+		{
+			KAOS::Logging::Error("Unable to decode tiled layer `" + layer->GetName() + "`");
+			return false;
+		}
+
+		if (hasFlippedTiles)
+		{
+			KAOS::Logging::Warn("Tiled layer `" + layer->GetName() + "` contains flipped or rotated tiles. Flip flags are not supported and were ignored.");
 		}
 
 		return true;
@@ -29,7 +29,8 @@ namespace DescriptorNodes
 
 	protected:
 
-		using rowcontainer_type = std::vector<Builder::MapDataSource::tilesetlayer_type::cell_type>;
+		using cell_type = Builder::MapDataSource::tilesetlayer_type::cell_type;
+		using rowcontainer_type = std::vector<cell_type>;
 		using rlecontainer_type = std::vector<std::pair<unsigned int, rowcontainer_type::value_type>>;
 
 		virtual rowcontainer_type compressRowData(rowcontainer_type rowData) const;
@@ -106,24 +106,24 @@ namespace DescriptorNodes
 			}
 
 			const auto& tileset(**tilesetPtr);
-			std::vector<KAOS::Tiled::Tile> tiles(tileset.GetTileCount());
-			for (const auto& tile : tileset.GetTiles())
-			{
-				tiles[tile.first] = tile.second;
-			}
+			const auto tileCount(static_cast<KAOS::Tiled::Tile::id_type>(tileset.GetTileCount()));
 
 
 			static const Builder::DataBuilder::property_type::word_type Signature = ('T' << 8) | 'D';
 
 
-			builder.EmitValue(std::string(), static_cast<Builder::DataBuilder::property_type::word_type>(tiles.size()), "Number of tiles");
+			builder.EmitValue(std::string(), static_cast<Builder::DataBuilder::property_type::word_type>(tileCount), "Number of tiles");
 			builder.EmitComment("", false);
 			builder.EmitComment("Attributes for tileset `" + tileset.GetName() + "`");
 			builder.EmitComment("", false);
 
-			for (const auto& tile : tiles)
+			//	Tile attributes are read from the tileset's per-property columns.
+			//	Tiles without a definition use default attributes.
+			Builder::TileDataSource tileDataSource(tileset, map, tilesetCache, descriptors, configuration);
+			for (KAOS::Tiled::Tile::id_type tileId(0); tileId < tileCount; ++tileId)
 			{
-				tileDescriptor->CompileInstance(builder, Builder::TileDataSource(tile, map, tilesetCache, descriptors, configuration), configuration);
+				tileDataSource.SetTileId(tileId);
+				tileDescriptor->CompileInstance(builder, tileDataSource, configuration);
 			}
 		}
 
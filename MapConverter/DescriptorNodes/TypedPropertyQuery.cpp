@@ -75,6 +75,7 @@ namespace DescriptorNodes
 		}
 
 		m_Key = nameAttr.as_string();
+		m_InternedKey = KAOS::Tiled::InternedString(m_Key);
 		m_Type = move(varType);
 		m_Value = move(varValue);
 
@@ -117,7 +118,7 @@ namespace DescriptorNodes
 		std::optional<KAOS::Tiled::NamedProperty> property;
 		if (!m_Key.empty())
 		{
-			property = dataSource.QueryProperty(m_Key);
+			property = dataSource.QueryInternedProperty(m_InternedKey);
 		}
 
 		if (!property.has_value())
@@ -48,6 +48,7 @@ namespace DescriptorNodes
 	private:
 
 		name_type					m_Key;
+		KAOS::Tiled::InternedString	m_InternedKey;
 		std::optional<vartype_id>	m_Type;
 		std::optional<value_type>	m_Value;
 	};
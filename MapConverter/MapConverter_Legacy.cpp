@@ -51,12 +51,12 @@ namespace
 
 	bool GenerateCode(
 		std::ostream& output,
-		KAOS::Tiled::TilesetCache tilesetCache,
+		KAOS::Tiled::TilesetCache& tilesetCache,
 		const KAOS::Tiled::Map& map,
 		const std::map<std::string, unsigned int>& objectList,
 		const unsigned int emptyCellId)
 	{
-		const auto allLayers(map.GetLayers());
+		const auto& allLayers(map.GetLayers());
 		std::vector<std::shared_ptr<const KAOS::Tiled::TilesetLayer>> tilesetLayers;
 		std::vector<std::shared_ptr<const KAOS::Tiled::ObjectGroupLayer>> objectGroupLayers;
 
@@ -97,8 +97,8 @@ namespace
 		}
 
 		KAOS::Tiled::NamedProperty::int_type frameDivider(0);
-		auto frameDividerValue(map.QueryProperty("FrameDivider"));
-		if (frameDividerValue.has_value())
+		const auto frameDividerValue(map.FindProperty("FrameDivider"));
+		if (frameDividerValue)
 		{
 			frameDividerValue->QueryValue(frameDivider);
 		}
@@ -136,23 +136,23 @@ namespace
 			output << "\tFDB\t"
 				<< '$' << std::setfill('0') << std::hex << std::fixed << std::setw(4) << objectGroup->size() << "\n";
 
-			for (const auto& object : *objectGroup)
+			for (const auto object : *objectGroup)
 			{
-				const auto typeIdPtr(objectList.find(object->GetType()));
+				const auto typeIdPtr(objectList.find(object.GetType()));
 				const auto typeId(typeIdPtr == objectList.end() ? -1 : typeIdPtr->second);
 				if (typeIdPtr == objectList.end())
 				{
-					std::cerr << "Object type `" << object->GetType() << "` not found.\n";
+					std::cerr << "Object type `" << object.GetType() << "` not found.\n";
 					hasError = true;
 				}
 
 				output << "\tFDB\t"
 					<< '$' << std::setfill('0') << std::hex << std::fixed << std::setw(4) << typeId
 					<< ','
-					<< '$' << std::setfill('0') << std::hex << std::fixed << std::setw(4) << object->GetXPos()
+					<< '$' << std::setfill('0') << std::hex << std::fixed << std::setw(4) << object.GetXPos()
 					<< ','
-					<< '$' << std::setfill('0') << std::hex << std::fixed << std::setw(4) << object->GetYPos()
-					<< "\t\t*\t" << object->GetName()
+					<< '$' << std::setfill('0') << std::hex << std::fixed << std::setw(4) << object.GetYPos()
+					<< "\t\t*\t" << object.GetName()
 					<< '\n';
 			}
 		}
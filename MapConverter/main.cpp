@@ -10,6 +10,7 @@
 #include <Tiled/Map.h>
 #include <Tiled/Tileset.h>
 #include <Tiled/TilesetCache.h>
+#include <Tiled/CacheFile.h>
 #include <KAOS/Common/Logging.h>
 #include <KAOS/Common/Utilities.h>
 #include <iostream>
@@ -18,6 +19,7 @@
 #include <iomanip>
 #include <fstream>
 #include <optional>
+#include <filesystem>
 
 
 bool GenerateDefinitions(
@@ -52,6 +54,9 @@ int main(int argc, const char **argv)
 	std::optional<std::string> defsOutputFilename;
 	std::optional<std::string> outputFilename;
 	std::optional<std::string> mapDescriptorNameID;
+	std::optional<std::string> tilesetCacheDirectory;
+	std::optional<size_t> tilesetCacheBudget;
+	std::optional<std::string> mapSnapshotDirectory;
 	Configuration configuration;
 	bool hasError(false);
 
@@ -160,6 +165,51 @@ int main(int argc, const char **argv)
 					defsOutputFilename = value;
 				}
 			}
+			else if (arg == "tileset-cache-dir")
+			{
+				if (tilesetCacheDirectory.has_value())
+				{
+					KAOS::Logging::Warn("Tileset cache directory already set to `" + *tilesetCacheDirectory + "`");
+				}
+				else if (value.empty())
+				{
+					KAOS::Logging::Warn("Empty argument for option --" + arg + " ignored.");
+				}
+				else
+				{
+					tilesetCacheDirectory = value;
+				}
+			}
+			else if (arg == "map-snapshot-dir")
+			{
+				if (mapSnapshotDirectory.has_value())
+				{
+					KAOS::Logging::Warn("Map snapshot directory already set to `" + *mapSnapshotDirectory + "`");
+				}
+				else if (value.empty())
+				{
+					KAOS::Logging::Warn("Empty argument for option --" + arg + " ignored.");
+				}
+				else
+				{
+					mapSnapshotDirectory = value;
+				}
+			}
+			else if (arg == "tileset-cache-budget")
+			{
+				if (tilesetCacheBudget.has_value())
+				{
+					KAOS::Logging::Warn("Tileset cache budget already set to `" + std::to_string(*tilesetCacheBudget) + "` KB");
+				}
+				else if (value.empty())
+				{
+					KAOS::Logging::Warn("Empty argument for option --" + arg + " ignored.");
+				}
+				else
+				{
+					tilesetCacheBudget = std::stoul(value);
+				}
+			}
 			else if (arg == "output-file")
 			{
 				if (outputFilename.has_value())
@@ -289,19 +339,58 @@ int main(int argc, const char **argv)
 	///////////////////////////////////////////////////////////////////////////////
 	if (mapFilename.has_value())
 	{
-		auto map(std::make_shared<KAOS::Tiled::Map>());
-		if (!map->Load(*mapFilename))
+		//	Snapshots are named after the absolute path of the map so maps with
+		//	the same filename in different directories do not collide.
+		std::string mapSnapshotFilepath;
+		if (mapSnapshotDirectory.has_value())
 		{
-			return EXIT_FAILURE;
+			std::error_code error;
+			std::filesystem::create_directories(*mapSnapshotDirectory, error);
+			if (error)
+			{
+				KAOS::Logging::Warn("Unable to create map snapshot directory `" + *mapSnapshotDirectory + "`. Map snapshots disabled.");
+			}
+			else
+			{
+				const auto absoluteMapFilename(KAOS::Common::EnsureAbsolutePath(*mapFilename));
+				const auto pathHash(KAOS::Tiled::HashBytes(absoluteMapFilename.data(), absoluteMapFilename.size()));
+				mapSnapshotFilepath = KAOS::Common::MakePath(
+					*mapSnapshotDirectory,
+					KAOS::Common::GetFilenameFromPath(*mapFilename, false) + "_" + KAOS::Common::to_hex_string(pathHash, 16) + ".ksmp");
+			}
 		}
 
-		auto tilesetCache(std::make_shared<KAOS::Tiled::TilesetCache >());
-		for (const auto& tilesetDescriptor : map->GetTilesets())
+		auto map(std::make_shared<KAOS::Tiled::Map>());
+		if (mapSnapshotFilepath.empty() || !map->LoadSnapshot(mapSnapshotFilepath, *mapFilename))
 		{
-			if (!tilesetCache->Load(tilesetDescriptor.GetSource()).has_value())
+			if (!map->Load(*mapFilename, KAOS::Tiled::Map::LayerLoading::Streamed))
 			{
 				return EXIT_FAILURE;
 			}
+
+			if (!mapSnapshotFilepath.empty() && !map->SaveSnapshot(mapSnapshotFilepath))
+			{
+				KAOS::Logging::Warn("Unable to save map snapshot. The map will be parsed again next time.");
+			}
+		}
+
+		auto tilesetCache(tilesetCacheDirectory.has_value()
+			? std::make_shared<KAOS::Tiled::TilesetCache>(*tilesetCacheDirectory)
+			: std::make_shared<KAOS::Tiled::TilesetCache>());
+		if (tilesetCacheBudget.has_value())
+		{
+			tilesetCache->SetMemoryBudget(*tilesetCacheBudget * 1024);
+		}
+
+		std::vector<std::string> tilesetFilepaths;
+		for (const auto& tilesetDescriptor : map->GetTilesets())
+		{
+			tilesetFilepaths.emplace_back(tilesetDescriptor.GetSource());
+		}
+
+		if (!tilesetCache->Preload(tilesetFilepaths))
+		{
+			return EXIT_FAILURE;
 		}
 
 		std::string finalOutputFilename;
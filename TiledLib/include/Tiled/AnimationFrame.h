@@ -25,6 +25,9 @@ namespace KAOS { namespace Tiled
 
 		bool Parse(const pugi::xml_node& node);
 
+		void Serialize(BinaryWriter& writer) const;
+		bool Deserialize(BinaryReader& reader);
+
 		id_type GetTileId() const;
 		duration_type GetDuration() const;
 
@@ -0,0 +1,178 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#pragma once
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <type_traits>
+
+
+namespace KAOS { namespace Tiled
+{
+
+	//	Minimal binary serialization used by the on-disk caches. Values are
+	//	written in native byte order; cache files are not meant to be shared
+	//	between machines.
+	class BinaryWriter
+	{
+	public:
+
+		using buffer_type = std::vector<char>;
+
+
+	public:
+
+		template<class Type_>
+		void Write(const Type_& value)
+		{
+			static_assert(std::is_arithmetic_v<Type_> || std::is_enum_v<Type_>, "Only arithmetic values can be written directly");
+
+			const auto bytes(reinterpret_cast<const char*>(&value));
+			m_Buffer.insert(m_Buffer.end(), bytes, bytes + sizeof(value));
+		}
+
+		void Write(const std::string& value)
+		{
+			Write(static_cast<uint32_t>(value.size()));
+			m_Buffer.insert(m_Buffer.end(), value.begin(), value.end());
+		}
+
+		//	Arrays of values are written as a single block
+		template<class Type_>
+		void Write(const std::vector<Type_>& values)
+		{
+			static_assert(std::is_arithmetic_v<Type_>, "Only arrays of arithmetic values can be written directly");
+
+			Write(static_cast<uint64_t>(values.size()));
+			WriteBytes(values.data(), values.size() * sizeof(Type_));
+		}
+
+		void WriteBytes(const void* data, size_t size)
+		{
+			const auto bytes(static_cast<const char*>(data));
+			m_Buffer.insert(m_Buffer.end(), bytes, bytes + size);
+		}
+
+		const buffer_type& GetBuffer() const
+		{
+			return m_Buffer;
+		}
+
+
+	private:
+
+		buffer_type	m_Buffer;
+	};
+
+
+	class BinaryReader
+	{
+	public:
+
+		BinaryReader(const char* data, size_t size)
+			: m_Current(data), m_End(data + size)
+		{}
+
+		template<class Type_>
+		bool Read(Type_& value)
+		{
+			static_assert(std::is_arithmetic_v<Type_> || std::is_enum_v<Type_>, "Only arithmetic values can be read directly");
+
+			if (static_cast<size_t>(m_End - m_Current) < sizeof(value))
+			{
+				return false;
+			}
+
+			std::memcpy(&value, m_Current, sizeof(value));
+			m_Current += sizeof(value);
+
+			return true;
+		}
+
+		bool Read(std::string& value)
+		{
+			uint32_t length;
+			if (!Read(length) || static_cast<size_t>(m_End - m_Current) < length)
+			{
+				return false;
+			}
+
+			value.assign(m_Current, length);
+			m_Current += length;
+
+			return true;
+		}
+
+		template<class Type_>
+		bool Read(std::vector<Type_>& values)
+		{
+			static_assert(std::is_arithmetic_v<Type_>, "Only arrays of arithmetic values can be read directly");
+
+			uint64_t count;
+			if (!Read(count) || static_cast<size_t>(m_End - m_Current) / sizeof(Type_) < count)
+			{
+				return false;
+			}
+
+			values.resize(static_cast<size_t>(count));
+
+			return ReadBytes(values.data(), values.size() * sizeof(Type_));
+		}
+
+		bool ReadBytes(void* data, size_t size)
+		{
+			if (static_cast<size_t>(m_End - m_Current) < size)
+			{
+				return false;
+			}
+
+			std::memcpy(data, m_Current, size);
+			m_Current += size;
+
+			return true;
+		}
+
+		bool IsAtEnd() const
+		{
+			return m_Current == m_End;
+		}
+
+
+	private:
+
+		const char*	m_Current;
+		const char*	m_End;
+	};
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
@@ -0,0 +1,70 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#pragma once
+#include "BinaryStream.h"
+#include <string>
+#include <optional>
+#include <cstdint>
+
+
+namespace KAOS { namespace Tiled
+{
+
+	//	Identifies the exact contents of a source file. Files derived from it
+	//	store the key and are only reused while it still matches.
+	struct SourceKey
+	{
+		std::string	path;
+		int64_t		modifiedTime = 0;
+		uint64_t	size = 0;
+		uint64_t	hash = 0;
+
+
+		static std::optional<SourceKey> Query(const std::string& filepath);
+
+		void Serialize(BinaryWriter& writer) const;
+		bool Deserialize(BinaryReader& reader);
+
+		bool operator==(const SourceKey& other) const;
+		bool operator!=(const SourceKey& other) const;
+	};
+
+
+	//	64 bit FNV-1a
+	uint64_t HashBytes(const char* data, size_t size);
+
+	//	Writes to a temporary file first and renames it into place so
+	//	concurrent builds never see a partially written file.
+	bool WriteCacheFile(const std::string& filepath, const BinaryWriter& writer);
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
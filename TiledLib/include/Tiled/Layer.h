@@ -5,8 +5,11 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #pragma once
+#include "InternedString.h"
+#include "BinaryStream.h"
 #include <pugixml/pugixml.hpp>
 #include <string>
+#include <memory>
 
 
 namespace KAOS { namespace Tiled
@@ -14,6 +17,12 @@ namespace KAOS { namespace Tiled
 
 	class Layer
 	{
+	public:
+
+		//	Keeps the document a lazily parsed layer refers to alive
+		using source_type = std::shared_ptr<const void>;
+
+
 	public:
 
 		Layer() = default;
@@ -24,12 +33,16 @@ namespace KAOS { namespace Tiled
 
 		virtual bool Parse(const pugi::xml_node& layer);
 
-		std::string GetName() const;
+		virtual void Serialize(BinaryWriter& writer) const;
+		virtual bool Deserialize(BinaryReader& reader);
+
+		const std::string& GetName() const;
+		const InternedString& GetInternedName() const;
 
 
 	private:
 
-		std::string		m_Name;
+		InternedString	m_Name;
 	};
 
 }}
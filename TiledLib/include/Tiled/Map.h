@@ -11,10 +11,12 @@
 #include "PropertyBag.h"
 #include "TilesetDescriptor.h"
 #include "Size.h"
+#include <KAOS/Common/xml.h>
 #include <pugixml/pugixml.hpp>
 #include <string>
 #include <vector>
 #include <memory>
+#include <unordered_map>
 
 
 namespace KAOS { namespace Tiled
@@ -42,9 +44,26 @@ namespace KAOS { namespace Tiled
 			LeftUp
 		};
 
+		//	Controls when layer data is decoded. Streamed tileset layers keep
+		//	the map document alive and decode their cells on demand (see
+		//	TilesetLayer::VisitRows) while object layers are parsed during
+		//	the load. Deferred tileset layers decode and keep their cells the
+		//	first time they are used and object layers parse their objects on
+		//	first use, so layers that are never queried cost nothing beyond
+		//	their attributes. Errors in deferred layers are reported when the
+		//	layer is first used rather than by Load().
+		enum class LayerLoading
+		{
+			Immediate,
+			Streamed,
+			Deferred
+		};
+
 
-		using layer_container_type = std::vector<std::shared_ptr<Layer>>;
+		using layer_container_type = std::vector<std::shared_ptr<const Layer>>;
 		using layer_const_iterator = layer_container_type::const_iterator;
+		using tileset_layer_container_type = std::vector<std::shared_ptr<TilesetLayer>>;
+		using object_layer_container_type = std::vector<std::shared_ptr<ObjectGroupLayer>>;
 		using tileset_container_type = std::vector<TilesetDescriptor>;
 		using color_type = KAOS::Imaging::Color;
 
@@ -56,12 +75,19 @@ namespace KAOS { namespace Tiled
 		Map(Map&&) = default;
 
 
-		bool Load(const std::string& filepath);
+		bool Load(const std::string& filepath, LayerLoading layerLoading = LayerLoading::Immediate);
 
+		//	Snapshots hold the fully decoded map along with a key of the source
+		//	file. LoadSnapshot() returns false without reporting an error if
+		//	the snapshot does not exist or `sourceFilepath` has changed since
+		//	the snapshot was saved.
+		bool SaveSnapshot(const std::string& snapshotFilepath) const;
+		bool LoadSnapshot(const std::string& snapshotFilepath, const std::string& sourceFilepath);
 
-		std::string GetFilePath() const;
-		std::string GetFilename() const;
-		std::string GetDirectory() const;
+
+		const std::string& GetFilePath() const;
+		const std::string& GetFilename() const;
+		const std::string& GetDirectory() const;
 		std::string GetName() const;
 		Size GetDimensions() const;
 		Size GetTileDimensions() const;
@@ -71,9 +97,12 @@ namespace KAOS { namespace Tiled
 
 		std::optional<NamedProperty::int_type> GetRightEdge() const;
 
-		std::vector<std::shared_ptr<const Layer>> GetLayers() const;
-		std::vector<TilesetDescriptor> GetTilesets() const;
+		const layer_container_type& GetLayers() const;
+		const tileset_layer_container_type& GetTilesetLayers() const;
+		const object_layer_container_type& GetObjectLayers() const;
+		const tileset_container_type& GetTilesets() const;
 		std::optional<PropertyBag::value_type> QueryProperty(const std::string& name) const;
+		const PropertyBag::value_type* FindProperty(const std::string& name) const;
 		std::shared_ptr<ObjectGroupLayer> QueryObjectLayer(const std::string& name) const;
 		std::shared_ptr<TilesetLayer> QueryTilesetLayer(const std::string& name) const;
 		std::shared_ptr<TilesetLayer> QueryTilesetLayer(uint64_t index) const;
@@ -81,23 +110,54 @@ namespace KAOS { namespace Tiled
 
 	protected:
 
-		bool Parse(const pugi::xml_node& mapNode, const std::string& filepath);
+		//	Layers grouped by kind and indexed by name so queries need neither
+		//	a linear search nor RTTI. When several layers of the same kind
+		//	share a name the first one in the map wins.
+		struct LayerIndex
+		{
+			tileset_layer_container_type	tilesetLayers;
+			object_layer_container_type		objectLayers;
+			std::unordered_map<InternedString, std::shared_ptr<TilesetLayer>>		tilesetLayersByName;
+			std::unordered_map<InternedString, std::shared_ptr<ObjectGroupLayer>>	objectLayersByName;
+
+			void Add(const std::shared_ptr<TilesetLayer>& layer);
+			void Add(const std::shared_ptr<ObjectGroupLayer>& layer);
+		};
+
+
+		bool Parse(
+			const pugi::xml_node& mapNode,
+			const std::string& filepath,
+			LayerLoading layerLoading,
+			const Layer::source_type& layerSource);
 
 		bool ParseChildren(
 			const pugi::xml_node& rootNode,
 			const std::string& mapDirectory,
+			LayerLoading layerLoading,
+			const Layer::source_type& layerSource,
 			layer_container_type& layers,
+			LayerIndex& layerIndex,
 			tileset_container_type& tilesetRefsOut,
 			PropertyBag& propertyBag) const;
 
+		void Serialize(BinaryWriter& writer) const;
+		bool Deserialize(BinaryReader& reader);
+
 		std::optional<Size> ParseMapDimensions(const pugi::xml_node& mapNode) const;
 		std::optional<Size> ParseTileDimensions(const pugi::xml_node& mapNode) const;
 		std::optional<Orientation> ParseOrientation(const pugi::xml_node& mapNode) const;
 		std::optional<RenderOrder> ParseRenderOrder(const pugi::xml_node& mapNode) const;
 		std::optional<KAOS::Imaging::Color> ParseBackgroundColor(const pugi::xml_node& mapNode) const;
 		std::optional<Stagger> ParseStagger(const pugi::xml_node& node) const;
-		std::shared_ptr<TilesetLayer> ParseTilesetLayerNode(const pugi::xml_node& layerNode) const;
-		std::shared_ptr<ObjectGroupLayer> ParseObjectGroupNode(const pugi::xml_node& objectGroupNode) const;
+		std::shared_ptr<TilesetLayer> ParseTilesetLayerNode(
+			const pugi::xml_node& layerNode,
+			LayerLoading layerLoading,
+			const Layer::source_type& layerSource) const;
+		std::shared_ptr<ObjectGroupLayer> ParseObjectGroupNode(
+			const pugi::xml_node& objectGroupNode,
+			LayerLoading layerLoading,
+			const Layer::source_type& layerSource) const;
 
 
 	private:
@@ -113,7 +173,9 @@ namespace KAOS { namespace Tiled
 		std::optional<color_type>	m_BackgroundColor;
 		PropertyBag					m_Properties;
 		layer_container_type		m_Layers;
+		LayerIndex					m_LayerIndex;
 		tileset_container_type		m_Tilesets;
+		std::shared_ptr<const Common::XML::MappedDocument>	m_Document;
 	};
 
 }}
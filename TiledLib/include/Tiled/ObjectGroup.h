@@ -5,51 +5,166 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #pragma once
-#include "Object.h"
+#include "PropertyBag.h"
+#include <pugixml/pugixml.hpp>
+#include <string>
 #include <vector>
 #include <memory>
+#include <iterator>
+#include <cstdint>
 
 
 namespace KAOS { namespace Tiled
 {
 
+	//	Objects are stored as parallel arrays. Names and types are interned
+	//	strings and the properties of all objects live in one array, sorted
+	//	by interned name id within each object. The storage is
+	//	immutable once parsed so copies of a group share it.
 	class ObjectGroup
 	{
+	protected:
+
+		struct Storage;
+
+
 	public:
 
-		using container_type = std::vector<std::shared_ptr<Object>>;
-		using value_type = container_type::value_type;
-		using const_iterator = container_type::const_iterator;
+		using size_type = size_t;
+		using id_type = unsigned int;
+		using property_type = PropertyBag::value_type;
+
+
+		//	Lightweight reference to a single object in a group. Only valid
+		//	while a group sharing the storage exists.
+		class ObjectView
+		{
+		public:
+
+			ObjectView(const Storage& storage, size_type index)
+				: m_Storage(&storage), m_Index(index)
+			{}
+
+			id_type GetId() const;
+			const std::string& GetName() const;
+			const std::string& GetType() const;
+			const InternedString& GetInternedName() const;
+			const InternedString& GetInternedType() const;
+			int GetXPos() const;
+			int GetYPos() const;
+
+			std::optional<property_type> QueryProperty(const std::string& name) const;
+			const property_type* FindProperty(const std::string& name) const;
+			const property_type* FindProperty(const InternedString& name) const;
+
+
+		private:
+
+			const Storage*	m_Storage;
+			size_type		m_Index;
+		};
+
+
+		class const_iterator
+		{
+		public:
+
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = ObjectView;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const ObjectView*;
+			using reference = ObjectView;
+
+
+		public:
+
+			const_iterator(const Storage& storage, size_type index)
+				: m_Storage(&storage), m_Index(index)
+			{}
+
+			ObjectView operator*() const
+			{
+				return ObjectView(*m_Storage, m_Index);
+			}
+
+			const_iterator& operator++()
+			{
+				++m_Index;
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				const auto previous(*this);
+				++m_Index;
+				return previous;
+			}
+
+			bool operator==(const const_iterator& other) const
+			{
+				return m_Index == other.m_Index;
+			}
+
+			bool operator!=(const const_iterator& other) const
+			{
+				return m_Index != other.m_Index;
+			}
+
+
+		private:
+
+			const Storage*	m_Storage;
+			size_type		m_Index;
+		};
+
+		using value_type = ObjectView;
 
 
 	public:
 
-		ObjectGroup() = default;
-		ObjectGroup(const ObjectGroup&);
+		ObjectGroup();
+		ObjectGroup(const ObjectGroup&) = default;
 		ObjectGroup(ObjectGroup&&) = default;
 
-		ObjectGroup& operator=(const ObjectGroup&);
+		ObjectGroup& operator=(const ObjectGroup&) = default;
 		ObjectGroup& operator=(ObjectGroup&&) = default;
 
 
 		bool Parse(const pugi::xml_node& objectGroupNode);
 
+		void Serialize(BinaryWriter& writer) const;
+		bool Deserialize(BinaryReader& reader);
+
 	
-		container_type::size_type size() const;
+		size_type size() const;
 		const_iterator begin() const;
 		const_iterator end() const;
+		ObjectView operator[](size_type index) const;
+
+
+	protected:
+
+		struct Storage
+		{
+			std::vector<id_type>		ids;
+			std::vector<int>			xPositions;
+			std::vector<int>			yPositions;
+			std::vector<InternedString>	names;
+			std::vector<InternedString>	types;
+			std::vector<uint32_t>		propertyOffsets;	//	Size + 1 entries into properties
+			std::vector<property_type>	properties;
+		};
 
 
 	private:
 
-		container_type	m_Objects;
+		std::shared_ptr<const Storage>	m_Storage;
 	};
 
 }}
 
 
 
-
 //	Copyright (c) 2018 Chet Simpson
 //	
 //	Permission is hereby granted, free of charge, to any person
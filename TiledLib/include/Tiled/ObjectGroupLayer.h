@@ -18,7 +18,7 @@ namespace KAOS { namespace Tiled
 	{
 	public:
 
-		using size_type = ObjectGroup::container_type::size_type;
+		using size_type = ObjectGroup::size_type;
 		using const_iterator = ObjectGroup::const_iterator;
 
 
@@ -31,6 +31,12 @@ namespace KAOS { namespace Tiled
 		ObjectGroupLayer& operator=(const ObjectGroupLayer&) = delete;
 
 		bool Parse(const pugi::xml_node& objectGroupNode) override;
+		//	Parses the layer attributes now and the objects the first time
+		//	the layer is used. `source` keeps the document alive until then.
+		bool ParseDeferred(const pugi::xml_node& objectGroupNode, source_type source);
+
+		void Serialize(BinaryWriter& writer) const override;
+		bool Deserialize(BinaryReader& reader) override;
 
 	
 		size_type size() const;
@@ -38,9 +44,17 @@ namespace KAOS { namespace Tiled
 		const_iterator end() const;
 
 
+	protected:
+
+		void EnsureParsed() const;
+
+
 	private:
 
-		ObjectGroup	m_ObjectGroup;
+		pugi::xml_node			m_ObjectGroupNode;
+		mutable source_type		m_Source;
+		mutable ObjectGroup		m_ObjectGroup;
+		mutable bool			m_IsParsed = false;
 	};
 
 }}
@@ -9,7 +9,7 @@
 #include <string>
 #include <vector>
 #include <optional>
-#include <map>
+#include <unordered_map>
 
 
 namespace KAOS { namespace Tiled
@@ -20,8 +20,9 @@ namespace KAOS { namespace Tiled
 	public:
 
 		using value_type = NamedProperty;
-		using container_type = std::map<std::string, value_type>;
+		using container_type = std::unordered_map<InternedString, value_type>;
 		using const_iterator = container_type::const_iterator;
+		using size_type = container_type::size_type;
 
 
 	public:
@@ -36,6 +37,14 @@ namespace KAOS { namespace Tiled
 
 		bool Parse(const pugi::xml_node& rootNode);
 
+		void Serialize(BinaryWriter& writer) const;
+		bool Deserialize(BinaryReader& reader);
+
+
+		size_type size() const
+		{
+			return m_Properties.size();
+		}
 
 		const_iterator begin() const
 		{
@@ -48,10 +57,27 @@ namespace KAOS { namespace Tiled
 		}
 
 		std::optional<value_type> find(const std::string& name) const
+		{
+			const auto property(lookup(name));
+
+			return property ? *property : std::optional<value_type>();
+		}
+
+		//	Same as find() without copying the property. Returns nullptr if the
+		//	property does not exist.
+		const value_type* lookup(const std::string& name) const
+		{
+			//	A name that was never interned cannot be a key in any bag
+			const auto key(InternedString::Find(name));
+
+			return key.has_value() ? lookup(*key) : nullptr;
+		}
+
+		const value_type* lookup(const InternedString& name) const
 		{
 			const auto property(m_Properties.find(name));
 
-			return property == m_Properties.end() ? std::optional<value_type>() : property->second;
+			return property == m_Properties.end() ? nullptr : &property->second;
 		}
 
 
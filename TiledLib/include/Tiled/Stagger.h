@@ -5,6 +5,7 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #pragma once
+#include "BinaryStream.h"
 #include <pugixml/pugixml.hpp>
 
 
@@ -34,6 +35,9 @@ namespace KAOS { namespace Tiled
 
 		bool Parse(const pugi::xml_node& mapNode);
 
+		void Serialize(BinaryWriter& writer) const;
+		bool Deserialize(BinaryReader& reader);
+
 		Axis GetAxis() const;
 		Index GetIndex() const;
 
@@ -0,0 +1,115 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#pragma once
+#include "NamedProperty.h"
+#include <optional>
+#include <string>
+#include <variant>
+#include <vector>
+
+
+namespace KAOS { namespace Tiled
+{
+
+	//	The values of one tile property for every tile in a tileset stored in
+	//	a dense array of the property's type indexed by local tile id. Tiles
+	//	that do not define the property are marked absent in a presence bitmap
+	//	and hold the default value of the type. Columns whose tiles disagree
+	//	on the type keep each value as a Property instead.
+	class TilePropertyColumn
+	{
+	public:
+
+		using value_type = NamedProperty;
+		using id_type = size_t;
+		using type_id = NamedProperty::id_type;
+		using storage_type = std::variant<
+			std::vector<NamedProperty::bool_type>,
+			std::vector<NamedProperty::int_type>,
+			std::vector<NamedProperty::float_type>,
+			std::vector<NamedProperty::color_type>,
+			std::vector<NamedProperty::string_type>,
+			std::vector<KAOS::Common::Property>>;
+
+
+	public:
+
+		TilePropertyColumn() = default;
+		TilePropertyColumn(InternedString name, type_id type, size_t tileCount);
+
+		const std::string& GetName() const;
+		const InternedString& GetInternedName() const;
+
+		//	Returns false if the tiles of the column have different types
+		bool IsTyped() const;
+		type_id GetType() const;
+
+		size_t size() const
+		{
+			return m_IsPresent.size();
+		}
+
+		bool HasValue(id_type tileId) const
+		{
+			return tileId < m_IsPresent.size() && m_IsPresent[tileId];
+		}
+
+		//	Returns the dense values of the column or nullptr if the column
+		//	does not hold values of Type_
+		template<class Type_>
+		const std::vector<Type_>* GetValues() const
+		{
+			return std::get_if<std::vector<Type_>>(&m_Values);
+		}
+
+		//	Returns an empty optional if the tile does not define the property
+		std::optional<value_type> find(id_type tileId) const;
+
+		//	Returns the default value of the column type if the tile does not
+		//	define the property
+		value_type operator[](id_type tileId) const;
+
+		void Set(id_type tileId, const KAOS::Common::Property& value);
+
+		size_t EstimateMemoryUsage() const;
+
+
+	private:
+
+		InternedString			m_Name;
+		type_id					m_Type = type_id::String;
+		storage_type			m_Values;
+		std::vector<bool>		m_IsPresent;
+	};
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
@@ -5,6 +5,7 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #pragma once
+#include "BinaryStream.h"
 #include <pugixml/pugixml.hpp>
 #include <string>
 
@@ -18,8 +19,11 @@ namespace KAOS { namespace Tiled
 
 		bool Parse(const pugi::xml_node& node, const std::string& mapDirectory);
 
+		void Serialize(BinaryWriter& writer) const;
+		bool Deserialize(BinaryReader& reader);
+
 		size_t GetGid() const;
-		std::string GetSource() const;
+		const std::string& GetSource() const;
 
 
 	private:
@@ -20,7 +20,10 @@ namespace KAOS { namespace Tiled
 
 		bool Parse(const pugi::xml_node& node);
 
-		std::string GetSource() const;
+		void Serialize(BinaryWriter& writer) const;
+		bool Deserialize(BinaryReader& reader);
+
+		const std::string& GetSource() const;
 		Size GetDimensions() const;
 
 
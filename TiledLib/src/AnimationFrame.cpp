@@ -35,6 +35,19 @@ namespace KAOS { namespace Tiled
 	}
 
 
+	void AnimationFrame::Serialize(BinaryWriter& writer) const
+	{
+		writer.Write(m_TileId);
+		writer.Write(m_Duration);
+	}
+
+
+	bool AnimationFrame::Deserialize(BinaryReader& reader)
+	{
+		return reader.Read(m_TileId) && reader.Read(m_Duration);
+	}
+
+
 
 
 	AnimationFrame::id_type AnimationFrame::GetTileId() const
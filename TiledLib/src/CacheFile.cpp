@@ -0,0 +1,163 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+#include <Tiled/CacheFile.h>
+#include <KAOS/Common/MappedFile.h>
+#include <filesystem>
+#include <fstream>
+#include <atomic>
+
+
+namespace KAOS { namespace Tiled
+{
+
+	namespace
+	{
+
+		//	Builds a temporary name next to the cache file that is unique to this
+		//	process and call so concurrent writers never share a partial file.
+		std::string MakeTemporaryFilepath(const std::string& filepath)
+		{
+			static std::atomic<unsigned int> counter(0);
+
+#ifdef _WIN32
+			const auto processId(_getpid());
+#else
+			const auto processId(getpid());
+#endif
+
+			return filepath + "." + std::to_string(processId) + "." + std::to_string(counter++) + ".tmp";
+		}
+
+	}
+
+
+	std::optional<SourceKey> SourceKey::Query(const std::string& filepath)
+	{
+		std::error_code error;
+		const auto modifiedTime(std::filesystem::last_write_time(filepath, error));
+		if (error)
+		{
+			return std::optional<SourceKey>();
+		}
+
+		Common::MappedFile file;
+		if (!file.Open(filepath))
+		{
+			return std::optional<SourceKey>();
+		}
+
+		SourceKey key;
+		key.path = filepath;
+		key.modifiedTime = static_cast<int64_t>(modifiedTime.time_since_epoch().count());
+		key.size = file.size();
+		key.hash = HashBytes(file.data(), file.size());
+
+		return key;
+	}
+
+
+	void SourceKey::Serialize(BinaryWriter& writer) const
+	{
+		writer.Write(path);
+		writer.Write(modifiedTime);
+		writer.Write(size);
+		writer.Write(hash);
+	}
+
+
+	bool SourceKey::Deserialize(BinaryReader& reader)
+	{
+		return reader.Read(path) && reader.Read(modifiedTime) && reader.Read(size) && reader.Read(hash);
+	}
+
+
+	bool SourceKey::operator==(const SourceKey& other) const
+	{
+		return path == other.path
+			&& modifiedTime == other.modifiedTime
+			&& size == other.size
+			&& hash == other.hash;
+	}
+
+
+	bool SourceKey::operator!=(const SourceKey& other) const
+	{
+		return !(*this == other);
+	}
+
+
+
+
+	uint64_t HashBytes(const char* data, size_t size)
+	{
+		uint64_t hash(14695981039346656037ULL);
+		for (auto end(data + size); data != end; ++data)
+		{
+			hash = (hash ^ static_cast<unsigned char>(*data)) * 1099511628211ULL;
+		}
+
+		return hash;
+	}
+
+
+	bool WriteCacheFile(const std::string& filepath, const BinaryWriter& writer)
+	{
+		const auto temporaryFilepath(MakeTemporaryFilepath(filepath));
+		std::error_code error;
+		{
+			std::ofstream output(temporaryFilepath, std::ios::binary | std::ios::trunc);
+			const auto& buffer(writer.GetBuffer());
+			if (!output.write(buffer.data(), buffer.size()) || !output.flush())
+			{
+				output.close();
+				std::filesystem::remove(temporaryFilepath, error);
+				return false;
+			}
+		}
+
+		std::filesystem::rename(temporaryFilepath, filepath, error);
+		if (error)
+		{
+			std::filesystem::remove(temporaryFilepath, error);
+			return false;
+		}
+
+		return true;
+	}
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
@@ -0,0 +1,152 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#include <Tiled/GidResolver.h>
+#include <Tiled/Tileset.h>
+#include <algorithm>
+#include <numeric>
+#include <iostream>
+
+
+namespace KAOS { namespace Tiled
+{
+
+	bool GidResolver::Build(const Map& map, TilesetCache& tilesetCache)
+	{
+		std::vector<size_t> tileCounts;
+		for (const auto& tilesetDescriptor : map.GetTilesets())
+		{
+			const auto tileset(tilesetCache.Load(tilesetDescriptor.GetSource()));
+			if (!tileset.has_value() || !*tileset)
+			{
+				std::cerr << "Unable to load tileset `" << tilesetDescriptor.GetSource() << "`\n";
+				return false;
+			}
+
+			tileCounts.push_back((*tileset)->GetTileCount());
+		}
+
+		return Build(map.GetTilesets(), tileCounts);
+	}
+
+
+	bool GidResolver::Build(const Map::tileset_container_type& tilesets, const std::vector<size_t>& tileCounts)
+	{
+		if (tilesets.size() != tileCounts.size())
+		{
+			std::cerr << "Number of tile counts does not match the number of tilesets\n";
+			return false;
+		}
+
+		//	Validate the GID ranges in ascending order so overlaps are easy to find
+		std::vector<size_t> order(tilesets.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::sort(order.begin(), order.end(), [&tilesets](size_t lhs, size_t rhs)
+		{
+			return tilesets[lhs].GetGid() < tilesets[rhs].GetGid();
+		});
+
+		size_t nextFreeGid(1);
+		for (const auto index : order)
+		{
+			const auto firstGid(tilesets[index].GetGid());
+			if (firstGid < nextFreeGid)
+			{
+				std::cerr << "Tileset `" << tilesets[index].GetSource() << "` overlaps the GID range of another tileset\n";
+				return false;
+			}
+
+			nextFreeGid = firstGid + tileCounts[index];
+			if (nextFreeGid > IdMask + size_t(1))
+			{
+				std::cerr << "Tileset `" << tilesets[index].GetSource() << "` exceeds the maximum GID\n";
+				return false;
+			}
+		}
+
+		std::vector<Entry> entries(nextFreeGid, Entry{ NoTileset, 0 });
+		for (size_t index(0); index < tilesets.size(); ++index)
+		{
+			const auto firstGid(tilesets[index].GetGid());
+			for (size_t localId(0); localId < tileCounts[index]; ++localId)
+			{
+				entries[firstGid + localId] = { static_cast<tileset_index_type>(index), static_cast<id_type>(localId) };
+			}
+		}
+
+		m_Entries = move(entries);
+		m_TileCounts = tileCounts;
+
+		return true;
+	}
+
+
+	size_t GidResolver::GetTilesetCount() const
+	{
+		return m_TileCounts.size();
+	}
+
+
+	size_t GidResolver::GetTileCount(tileset_index_type tilesetIndex) const
+	{
+		return m_TileCounts.at(tilesetIndex);
+	}
+
+
+	bool GidResolver::Resolve(const gid_type* begin, const gid_type* end, ResolvedCell* resolvedOut) const
+	{
+		//	Branch free so the loop stays tight on large rows: out of range
+		//	GIDs are clamped to the empty entry and reported after the loop.
+		const auto entries(m_Entries.data());
+		const auto entryCount(m_Entries.size());
+		bool isValid(true);
+		for (auto gid(begin); gid != end; ++gid, ++resolvedOut)
+		{
+			const auto id(*gid & IdMask);
+			const auto inRange(id < entryCount);
+			const auto& entry(entries[inRange ? id : 0]);
+
+			resolvedOut->tilesetIndex = entry.tilesetIndex;
+			resolvedOut->localId = entry.localId;
+			resolvedOut->flags = static_cast<uint8_t>(*gid >> FlagShift);
+			isValid &= !id || (inRange && entry.tilesetIndex != NoTileset);
+		}
+
+		if (!isValid)
+		{
+			std::cerr << "Layer contains a GID that does not belong to any tileset\n";
+		}
+
+		return isValid;
+	}
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
@@ -0,0 +1,97 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#include <Tiled/InternedString.h>
+#include <unordered_set>
+#include <mutex>
+
+
+namespace KAOS { namespace Tiled
+{
+
+	namespace
+	{
+
+		//	Nodes of an unordered_set never move so pointers to the strings
+		//	remain valid as the pool grows.
+		struct StringPool
+		{
+			std::mutex						mutex;
+			std::unordered_set<std::string>	strings;
+		};
+
+
+		StringPool& GetStringPool()
+		{
+			static StringPool pool;
+
+			return pool;
+		}
+
+	}
+
+
+
+
+	const std::string InternedString::m_EmptyString;
+
+
+	std::optional<InternedString> InternedString::Find(const std::string& text)
+	{
+		if (text.empty())
+		{
+			return InternedString();
+		}
+
+		auto& pool(GetStringPool());
+		std::lock_guard<std::mutex> lock(pool.mutex);
+
+		const auto existing(pool.strings.find(text));
+
+		return existing != pool.strings.end() ? InternedString(&*existing) : std::optional<InternedString>();
+	}
+
+
+	const std::string* InternedString::Intern(const std::string& text)
+	{
+		if (text.empty())
+		{
+			return &m_EmptyString;
+		}
+
+		auto& pool(GetStringPool());
+		std::lock_guard<std::mutex> lock(pool.mutex);
+
+		return &*pool.strings.insert(text).first;
+	}
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
@@ -21,13 +21,39 @@ namespace KAOS { namespace Tiled
 			return false;
 		}
 
-		m_Name = nameAttr.as_string();
+		m_Name = InternedString(nameAttr.as_string());
 
 		return true;
 	}
 
 
-	std::string Layer::GetName() const
+	void Layer::Serialize(BinaryWriter& writer) const
+	{
+		writer.Write(m_Name.str());
+	}
+
+
+	bool Layer::Deserialize(BinaryReader& reader)
+	{
+		std::string name;
+		if (!reader.Read(name))
+		{
+			return false;
+		}
+
+		m_Name = InternedString(name);
+
+		return true;
+	}
+
+
+	const std::string& Layer::GetName() const
+	{
+		return m_Name;
+	}
+
+
+	const InternedString& Layer::GetInternedName() const
 	{
 		return m_Name;
 	}
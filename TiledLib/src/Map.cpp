@@ -5,28 +5,46 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #include <Tiled/Map.h>
+#include <Tiled/CacheFile.h>
 #include <KAOS/Common/Utilities.h>
+#include <KAOS/Common/MappedFile.h>
 #include <KAOS/Imaging/ImageUtils.h>
 #include <iostream>
-#include <algorithm>
 
 
 namespace KAOS { namespace Tiled
 {
 
-	std::string Map::GetFilePath() const
+	namespace
+	{
+
+		const uint32_t SnapshotSignature = 0x504d534b;	//	"KSMP"
+		const uint32_t SnapshotVersion = 1;
+
+		enum class SnapshotLayerKind : uint8_t
+		{
+			Tileset,
+			ObjectGroup
+		};
+
+	}
+
+
+
+
+	const std::string& Map::GetFilePath() const
 	{
 		return m_Filepath;
 	}
 
 
-	std::string Map::GetFilename() const
+	const std::string& Map::GetFilename() const
 	{
 		return m_Filename;
 	}
 
 
-	std::string Map::GetDirectory() const
+	const std::string& Map::GetDirectory() const
 	{
 		return m_Directory;
 	}
@@ -34,9 +52,9 @@ namespace KAOS { namespace Tiled
 
 	std::string Map::GetName() const
 	{
-		auto nameProperty(m_Properties.find("Name"));
+		const auto nameProperty(m_Properties.lookup("Name"));
 		std::string name;
-		if (!nameProperty.has_value())
+		if (!nameProperty)
 		{
 			name = "<UNNAMED>";
 		}
@@ -90,9 +108,9 @@ namespace KAOS { namespace Tiled
 
 	std::optional<NamedProperty::int_type> Map::GetRightEdge() const
 	{
-		auto value(QueryProperty("RightEdge"));
+		const auto value(FindProperty("RightEdge"));
 		NamedProperty::int_type rightEdge(0);
-		if (!value.has_value() || !value->QueryValue<decltype(rightEdge)>(rightEdge))
+		if (!value || !value->QueryValue<decltype(rightEdge)>(rightEdge))
 		{
 			return GetDimensions().GetWidth();
 		}
@@ -107,66 +125,65 @@ namespace KAOS { namespace Tiled
 	}
 
 
+	const PropertyBag::value_type* Map::FindProperty(const std::string& name) const
+	{
+		return m_Properties.lookup(name);
+	}
+
+
 	std::shared_ptr<ObjectGroupLayer> Map::QueryObjectLayer(const std::string& name) const
 	{
-		auto layer(std::find_if(
-			m_Layers.begin(),
-			m_Layers.end(),
-			[&name](std::shared_ptr<Layer> layer) -> bool
-			{
-				return layer->GetName() == name;
-			}));
-		
-		return layer != m_Layers.end() ? std::dynamic_pointer_cast<ObjectGroupLayer>(*layer) : nullptr;
+		const auto key(InternedString::Find(name));
+		if (!key.has_value())
+		{
+			return nullptr;
+		}
+
+		const auto layer(m_LayerIndex.objectLayersByName.find(*key));
+
+		return layer != m_LayerIndex.objectLayersByName.end() ? layer->second : nullptr;
 	}
 
 
 	std::shared_ptr<TilesetLayer> Map::QueryTilesetLayer(const std::string& name) const
 	{
-		auto layer(std::find_if(
-			m_Layers.begin(),
-			m_Layers.end(),
-			[&name](std::shared_ptr<Layer> layer) -> bool
-			{
-				return layer->GetName() == name;
-			}));
-		
-		return layer != m_Layers.end() ? std::dynamic_pointer_cast<TilesetLayer>(*layer) : nullptr;
+		const auto key(InternedString::Find(name));
+		if (!key.has_value())
+		{
+			return nullptr;
+		}
+
+		const auto layer(m_LayerIndex.tilesetLayersByName.find(*key));
+
+		return layer != m_LayerIndex.tilesetLayersByName.end() ? layer->second : nullptr;
 	}
 
 
 	std::shared_ptr<TilesetLayer> Map::QueryTilesetLayer(uint64_t index) const
 	{
-		auto count(index);
-		auto layer(std::find_if(
-			m_Layers.begin(),
-			m_Layers.end(),
-			[&count](std::shared_ptr<Layer> layer) -> bool
-			{
-				if (std::dynamic_pointer_cast<TilesetLayer>(layer))
-				{
-					if (!count)
-					{
-						return true;
-					}
+		return index < m_LayerIndex.tilesetLayers.size() ? m_LayerIndex.tilesetLayers[index] : nullptr;
+	}
 
-					--count;
-				}
 
-				return false;
-			}));
-		
-		return layer != m_Layers.end() ? std::dynamic_pointer_cast<TilesetLayer>(*layer) : nullptr;
+	const Map::layer_container_type& Map::GetLayers() const
+	{
+		return m_Layers;
 	}
 
 
-	std::vector<std::shared_ptr<const Layer>> Map::GetLayers() const
+	const Map::tileset_layer_container_type& Map::GetTilesetLayers() const
 	{
-		return std::vector<std::shared_ptr<const Layer>>(m_Layers.begin(), m_Layers.end());
+		return m_LayerIndex.tilesetLayers;
 	}
 
 
-	std::vector<TilesetDescriptor> Map::GetTilesets() const
+	const Map::object_layer_container_type& Map::GetObjectLayers() const
+	{
+		return m_LayerIndex.objectLayers;
+	}
+
+
+	const Map::tileset_container_type& Map::GetTilesets() const
 	{
 		return m_Tilesets;
 	}
@@ -174,32 +191,270 @@ namespace KAOS { namespace Tiled
 
 
 
-	bool Map::Load(const std::string& filepath)
+	bool Map::Load(const std::string& filepath, LayerLoading layerLoading)
 	{
-		pugi::xml_document doc;
-
-		auto result(doc.load_file(filepath.c_str()));
-		if (!result)
+		auto document(std::make_shared<Common::XML::MappedDocument>());
+		if (!document->Load(filepath))
 		{
 			std::cerr << "Unable to open `" << filepath << "`\n";
 			return false;
 		}
 
 
-		auto mapNode(doc.child("map"));
+		auto mapNode(document->GetDocument().child("map"));
 		if (mapNode.empty())
 		{
 			std::cerr << "File does not appear to contain a map\n";
 			return false;
 		}
 
-		return Parse(mapNode, filepath);
+		Layer::source_type layerSource;
+		if (layerLoading != LayerLoading::Immediate)
+		{
+			layerSource = document;
+		}
+
+		if (!Parse(mapNode, filepath, layerLoading, layerSource))
+		{
+			return false;
+		}
+
+		m_Document = move(document);
+
+		return true;
 	}
 
 
 
 
-	bool Map::Parse(const pugi::xml_node& mapNode, const std::string& filepath)
+	bool Map::SaveSnapshot(const std::string& snapshotFilepath) const
+	{
+		const auto sourceKey(SourceKey::Query(m_Filepath));
+		if (!sourceKey.has_value())
+		{
+			std::cerr << "Unable to read `" << m_Filepath << "` while saving map snapshot\n";
+			return false;
+		}
+
+		BinaryWriter writer;
+		writer.Write(SnapshotSignature);
+		writer.Write(SnapshotVersion);
+		sourceKey->Serialize(writer);
+		Serialize(writer);
+
+		if (!WriteCacheFile(snapshotFilepath, writer))
+		{
+			std::cerr << "Unable to write map snapshot `" << snapshotFilepath << "`\n";
+			return false;
+		}
+
+		return true;
+	}
+
+
+	bool Map::LoadSnapshot(const std::string& snapshotFilepath, const std::string& sourceFilepath)
+	{
+		const auto sourceKey(SourceKey::Query(Common::EnsureAbsolutePath(sourceFilepath)));
+		if (!sourceKey.has_value())
+		{
+			return false;
+		}
+
+		Common::MappedFile file;
+		if (!file.Open(snapshotFilepath))
+		{
+			return false;
+		}
+
+		BinaryReader reader(file.data(), file.size());
+		uint32_t signature, version;
+		SourceKey snapshotKey;
+		if (   !reader.Read(signature) || signature != SnapshotSignature
+			|| !reader.Read(version) || version != SnapshotVersion
+			|| !snapshotKey.Deserialize(reader) || snapshotKey != *sourceKey)
+		{
+			return false;
+		}
+
+		if (!Deserialize(reader))
+		{
+			std::cerr << "WARNING: Ignoring corrupt map snapshot `" << snapshotFilepath << "`\n";
+			return false;
+		}
+
+		return true;
+	}
+
+
+	void Map::Serialize(BinaryWriter& writer) const
+	{
+		writer.Write(m_Filepath);
+		writer.Write(m_Filename);
+		writer.Write(m_Directory);
+		writer.Write(m_MapDimensions.GetWidth());
+		writer.Write(m_MapDimensions.GetHeight());
+		writer.Write(m_TileDimensions.GetWidth());
+		writer.Write(m_TileDimensions.GetHeight());
+		writer.Write(m_Orientation);
+		writer.Write(m_RenderOrder);
+		m_StaggerConfig.Serialize(writer);
+		writer.Write(m_BackgroundColor.has_value());
+		if (m_BackgroundColor.has_value())
+		{
+			writer.Write(m_BackgroundColor->red);
+			writer.Write(m_BackgroundColor->green);
+			writer.Write(m_BackgroundColor->blue);
+			writer.Write(m_BackgroundColor->alpha);
+		}
+
+		m_Properties.Serialize(writer);
+
+		writer.Write(static_cast<uint64_t>(m_Tilesets.size()));
+		for (const auto& tileset : m_Tilesets)
+		{
+			tileset.Serialize(writer);
+		}
+
+		writer.Write(static_cast<uint64_t>(m_Layers.size()));
+		for (const auto& layer : m_Layers)
+		{
+			writer.Write(std::dynamic_pointer_cast<const TilesetLayer>(layer)
+				? SnapshotLayerKind::Tileset
+				: SnapshotLayerKind::ObjectGroup);
+			layer->Serialize(writer);
+		}
+	}
+
+
+	bool Map::Deserialize(BinaryReader& reader)
+	{
+		std::string filepath, filename, directory;
+		Size::value_type mapWidth, mapHeight, tileWidth, tileHeight;
+		Orientation orientation;
+		RenderOrder renderOrder;
+		Stagger stagger;
+		bool hasBackgroundColor;
+		if (   !reader.Read(filepath)
+			|| !reader.Read(filename)
+			|| !reader.Read(directory)
+			|| !reader.Read(mapWidth)
+			|| !reader.Read(mapHeight)
+			|| !reader.Read(tileWidth)
+			|| !reader.Read(tileHeight)
+			|| !reader.Read(orientation)
+			|| !reader.Read(renderOrder)
+			|| !stagger.Deserialize(reader)
+			|| !reader.Read(hasBackgroundColor))
+		{
+			return false;
+		}
+
+		std::optional<color_type> backgroundColor;
+		if (hasBackgroundColor)
+		{
+			color_type color;
+			if (!reader.Read(color.red) || !reader.Read(color.green) || !reader.Read(color.blue) || !reader.Read(color.alpha))
+			{
+				return false;
+			}
+
+			backgroundColor = color;
+		}
+
+		PropertyBag propertyBag;
+		uint64_t tilesetCount;
+		if (!propertyBag.Deserialize(reader) || !reader.Read(tilesetCount))
+		{
+			return false;
+		}
+
+		tileset_container_type tilesetReferences;
+		for (auto i(0ULL); i < tilesetCount; ++i)
+		{
+			TilesetDescriptor tilesetRef;
+			if (!tilesetRef.Deserialize(reader))
+			{
+				return false;
+			}
+
+			tilesetReferences.emplace_back(std::move(tilesetRef));
+		}
+
+		uint64_t layerCount;
+		if (!reader.Read(layerCount))
+		{
+			return false;
+		}
+
+		layer_container_type layers;
+		LayerIndex layerIndex;
+		for (auto i(0ULL); i < layerCount; ++i)
+		{
+			SnapshotLayerKind kind;
+			if (!reader.Read(kind))
+			{
+				return false;
+			}
+
+			if (kind == SnapshotLayerKind::Tileset)
+			{
+				auto layer(std::make_shared<TilesetLayer>());
+				if (!layer->Deserialize(reader))
+				{
+					return false;
+				}
+
+				layerIndex.Add(layer);
+				layers.emplace_back(std::move(layer));
+			}
+			else if (kind == SnapshotLayerKind::ObjectGroup)
+			{
+				auto objectGroup(std::make_shared<ObjectGroupLayer>());
+				if (!objectGroup->Deserialize(reader))
+				{
+					return false;
+				}
+
+				layerIndex.Add(objectGroup);
+				layers.emplace_back(std::move(objectGroup));
+			}
+			else
+			{
+				return false;
+			}
+		}
+
+		if (!reader.IsAtEnd())
+		{
+			return false;
+		}
+
+		m_Filepath = move(filepath);
+		m_Filename = move(filename);
+		m_Directory = move(directory);
+		m_MapDimensions = Size(static_cast<unsigned int>(mapWidth), static_cast<unsigned int>(mapHeight));
+		m_TileDimensions = Size(static_cast<unsigned int>(tileWidth), static_cast<unsigned int>(tileHeight));
+		m_Orientation = orientation;
+		m_RenderOrder = renderOrder;
+		m_StaggerConfig = stagger;
+		m_BackgroundColor = backgroundColor;
+		m_Properties = std::move(propertyBag);
+		m_Layers = move(layers);
+		m_LayerIndex = std::move(layerIndex);
+		m_Tilesets = move(tilesetReferences);
+		m_Document.reset();
+
+		return true;
+	}
+
+
+
+
+	bool Map::Parse(
+		const pugi::xml_node& mapNode,
+		const std::string& filepath,
+		LayerLoading layerLoading,
+		const Layer::source_type& layerSource)
 	{
 		const auto mapDimensions(ParseMapDimensions(mapNode));
 		if (!mapDimensions.has_value())
@@ -243,10 +498,11 @@ namespace KAOS { namespace Tiled
 		auto filename(Common::GetFilenameFromPath(filepath, true));
 
 		layer_container_type layers;
+		LayerIndex layerIndex;
 		PropertyBag propertyBag;
 		tileset_container_type tilesetReferences;
 
-		if (!ParseChildren(mapNode, absoluteDirectory, layers, tilesetReferences, propertyBag))
+		if (!ParseChildren(mapNode, absoluteDirectory, layerLoading, layerSource, layers, layerIndex, tilesetReferences, propertyBag))
 		{
 			return false;
 		}
@@ -263,6 +519,7 @@ namespace KAOS { namespace Tiled
 		m_BackgroundColor = backgroundColor;
 		m_Properties = std::move(propertyBag);
 		m_Layers = move(layers);
+		m_LayerIndex = std::move(layerIndex);
 		m_Tilesets = move(tilesetReferences);
 
 		return true;
@@ -274,11 +531,15 @@ namespace KAOS { namespace Tiled
 	bool Map::ParseChildren(
 		const pugi::xml_node& mapNode,
 		const std::string& mapDirectory,
+		LayerLoading layerLoading,
+		const Layer::source_type& layerSource,
 		layer_container_type& layersOut,
+		LayerIndex& layerIndexOut,
 		tileset_container_type& tilesetRefsOut,
 		PropertyBag& propertyBagOut) const
 	{
 		layer_container_type layers;
+		LayerIndex layerIndex;
 		PropertyBag propertyBag;
 		tileset_container_type tilesetReferences;
 
@@ -309,12 +570,13 @@ namespace KAOS { namespace Tiled
 			}
 			else if (childName == "layer")
 			{
-				auto layer(ParseTilesetLayerNode(child));
+				auto layer(ParseTilesetLayerNode(child, layerLoading, layerSource));
 				if (!layer)
 				{
 					return false;
 				}
 
+				layerIndex.Add(layer);
 				layers.emplace_back(std::move(layer));
 			}
 			else if (childName == "group")
@@ -324,12 +586,13 @@ namespace KAOS { namespace Tiled
 			}
 			else if (childName == "objectgroup")
 			{
-				auto objectGroup(ParseObjectGroupNode(child));
+				auto objectGroup(ParseObjectGroupNode(child, layerLoading, layerSource));
 				if (!objectGroup)
 				{
 					return false;
 				}
 
+				layerIndex.Add(objectGroup);
 				layers.emplace_back(move(objectGroup));
 			}
 			else
@@ -347,6 +610,7 @@ namespace KAOS { namespace Tiled
 
 
 		layersOut = move(layers);
+		layerIndexOut = std::move(layerIndex);
 		propertyBagOut = std::move(propertyBag);
 		tilesetRefsOut = move(tilesetReferences);
 
@@ -357,6 +621,22 @@ namespace KAOS { namespace Tiled
 
 
 
+	void Map::LayerIndex::Add(const std::shared_ptr<TilesetLayer>& layer)
+	{
+		tilesetLayersByName.emplace(layer->GetInternedName(), layer);
+		tilesetLayers.emplace_back(layer);
+	}
+
+
+	void Map::LayerIndex::Add(const std::shared_ptr<ObjectGroupLayer>& layer)
+	{
+		objectLayersByName.emplace(layer->GetInternedName(), layer);
+		objectLayers.emplace_back(layer);
+	}
+
+
+
+
 	std::optional<Stagger> Map::ParseStagger(const pugi::xml_node& mapNode) const
 	{
 		Stagger stagger;
@@ -490,10 +770,29 @@ namespace KAOS { namespace Tiled
 
 
 
-	std::shared_ptr<TilesetLayer> Map::ParseTilesetLayerNode(const pugi::xml_node& layerNode) const
+	std::shared_ptr<TilesetLayer> Map::ParseTilesetLayerNode(
+		const pugi::xml_node& layerNode,
+		LayerLoading layerLoading,
+		const Layer::source_type& layerSource) const
 	{
 		auto layer(std::make_shared<TilesetLayer>());
-		if (!layer->Parse(layerNode))
+		bool parsed(false);
+		switch (layerLoading)
+		{
+		case LayerLoading::Immediate:
+			parsed = layer->Parse(layerNode);
+			break;
+
+		case LayerLoading::Streamed:
+			parsed = layer->ParseStreamed(layerNode, layerSource);
+			break;
+
+		case LayerLoading::Deferred:
+			parsed = layer->ParseDeferred(layerNode, layerSource);
+			break;
+		}
+
+		if (!parsed)
 		{
 			return nullptr;
 		}
@@ -504,10 +803,19 @@ namespace KAOS { namespace Tiled
 
 
 
-	std::shared_ptr<ObjectGroupLayer> Map::ParseObjectGroupNode(const pugi::xml_node& objectGroupNode) const
+	std::shared_ptr<ObjectGroupLayer> Map::ParseObjectGroupNode(
+		const pugi::xml_node& objectGroupNode,
+		LayerLoading layerLoading,
+		const Layer::source_type& layerSource) const
 	{
 		auto objectGroup(std::make_shared<ObjectGroupLayer>());
-		if (!objectGroup->Parse(objectGroupNode))
+		//	Objects cannot be streamed so only Deferred loading postpones
+		//	parsing them. Streamed maps parse objects up front so malformed
+		//	objects still fail the load.
+		const auto parsed(layerLoading == LayerLoading::Deferred
+			? objectGroup->ParseDeferred(objectGroupNode, layerSource)
+			: objectGroup->Parse(objectGroupNode));
+		if (!parsed)
 		{
 			return nullptr;
 		}
@@ -12,38 +12,45 @@
 namespace KAOS { namespace Tiled
 {
 
-	NamedProperty::NamedProperty(std::string name, const bool_type& value)
+	NamedProperty::NamedProperty(const std::string& name, const bool_type& value)
 		:
 		Property(value),
-		m_Name(move(name))
+		m_Name(name)
 	{}
 
 
-	NamedProperty::NamedProperty(std::string name, const int_type& value)
+	NamedProperty::NamedProperty(const std::string& name, const int_type& value)
 		:
 		Property(value),
-		m_Name(move(name))
+		m_Name(name)
 	{}
 
 
-	NamedProperty::NamedProperty(std::string name, const float_type& value)
+	NamedProperty::NamedProperty(const std::string& name, const float_type& value)
 		:
 		Property(value),
-		m_Name(move(name))
+		m_Name(name)
 	{}
 
 
-	NamedProperty::NamedProperty(std::string name, const color_type& value)
+	NamedProperty::NamedProperty(const std::string& name, const color_type& value)
 		:
 		Property(value),
-		m_Name(move(name))
+		m_Name(name)
 	{}
 
 
-	NamedProperty::NamedProperty(std::string name, string_type value)
+	NamedProperty::NamedProperty(const std::string& name, string_type value)
 		:
 		Property(move(value)),
-		m_Name(move(name))
+		m_Name(name)
+	{}
+
+
+	NamedProperty::NamedProperty(const InternedString& name, KAOS::Common::Property value)
+		:
+		Property(std::move(value)),
+		m_Name(name)
 	{}
 
 
@@ -105,7 +112,7 @@ namespace KAOS { namespace Tiled
 			return false;
 		}
 
-		m_Name = nameAttr.as_string();
+		m_Name = InternedString(nameAttr.as_string());
 
 		return true;
 	}
@@ -113,7 +120,142 @@ namespace KAOS { namespace Tiled
 
 
 
-	std::string NamedProperty::GetName() const
+	void NamedProperty::Serialize(BinaryWriter& writer) const
+	{
+		writer.Write(m_Name.str());
+		writer.Write(GetType());
+
+		switch (GetType())
+		{
+		case id_type::Boolean:
+			{
+				bool_type value(false);
+				QueryValue(value);
+				writer.Write(value);
+			}
+			break;
+
+		case id_type::Integer:
+			{
+				int_type value(0);
+				QueryValue(value);
+				writer.Write(value);
+			}
+			break;
+
+		case id_type::Float:
+			{
+				float_type value(0);
+				QueryValue(value);
+				writer.Write(value);
+			}
+			break;
+
+		case id_type::Color:
+			{
+				color_type value;
+				QueryValue(value);
+				writer.Write(value.red);
+				writer.Write(value.green);
+				writer.Write(value.blue);
+				writer.Write(value.alpha);
+			}
+			break;
+
+		case id_type::String:
+			{
+				string_type value;
+				QueryValue(value);
+				writer.Write(value);
+			}
+			break;
+		}
+	}
+
+
+	bool NamedProperty::Deserialize(BinaryReader& reader)
+	{
+		std::string name;
+		id_type type;
+		if (!reader.Read(name) || !reader.Read(type))
+		{
+			return false;
+		}
+
+		switch (type)
+		{
+		case id_type::Boolean:
+			{
+				bool_type value;
+				if (!reader.Read(value))
+				{
+					return false;
+				}
+				Set(value);
+			}
+			break;
+
+		case id_type::Integer:
+			{
+				int_type value;
+				if (!reader.Read(value))
+				{
+					return false;
+				}
+				Set(value);
+			}
+			break;
+
+		case id_type::Float:
+			{
+				float_type value;
+				if (!reader.Read(value))
+				{
+					return false;
+				}
+				Set(value);
+			}
+			break;
+
+		case id_type::Color:
+			{
+				color_type value;
+				if (!reader.Read(value.red) || !reader.Read(value.green) || !reader.Read(value.blue) || !reader.Read(value.alpha))
+				{
+					return false;
+				}
+				Set(value);
+			}
+			break;
+
+		case id_type::String:
+			{
+				string_type value;
+				if (!reader.Read(value))
+				{
+					return false;
+				}
+				Set(move(value));
+			}
+			break;
+
+		default:
+			return false;
+		}
+
+		m_Name = InternedString(name);
+
+		return true;
+	}
+
+
+	const std::string& NamedProperty::GetName() const
+	{
+		return m_Name;
+	}
+
+
+	const InternedString& NamedProperty::GetInternedName() const
 	{
 		return m_Name;
 	}
@@ -70,8 +70,8 @@ namespace KAOS { namespace Tiled
 			}
 		}
 
-		m_Name = move(name);
-		m_Type = move(type);
+		m_Name = InternedString(name);
+		m_Type = InternedString(type);
 		m_XPos = xPos;
 		m_YPos = yPos;
 		m_PropertyBag = std::move(propertyBag);
@@ -82,12 +82,12 @@ namespace KAOS { namespace Tiled
 
 
 
-	std::string Object::GetName() const
+	const std::string& Object::GetName() const
 	{
 		return m_Name;
 	}
 
-	std::string Object::GetType() const
+	const std::string& Object::GetType() const
 	{
 		return m_Type;
 	}
@@ -107,6 +107,11 @@ namespace KAOS { namespace Tiled
 		return m_PropertyBag.find(name);
 	}
 
+	const PropertyBag::value_type* Object::FindProperty(const std::string& name) const
+	{
+		return m_PropertyBag.lookup(name);
+	}
+
 }}
 
 
@@ -5,7 +5,6 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #include <Tiled/ObjectGroup.h>
-#include <memory>
 #include <iostream>
 #include <algorithm>
 
@@ -15,51 +14,226 @@ namespace KAOS { namespace Tiled
 
 	namespace
 	{
-		template<class Type_>
-		std::vector<Type_> CloneVector(const std::vector<Type_>& objects)
+
+		//	Orders an object's properties by interned id for FindProperty. Ids
+		//	differ between processes so the order is rebuilt whenever
+		//	properties are read and never written out.
+		void SortObjectProperties(
+			std::vector<ObjectGroup::property_type>::iterator first,
+			std::vector<ObjectGroup::property_type>::iterator last)
+		{
+			std::sort(
+				first,
+				last,
+				[](const ObjectGroup::property_type& lhs, const ObjectGroup::property_type& rhs)
+				{
+					return lhs.GetInternedName().GetId() < rhs.GetInternedName().GetId();
+				});
+		}
+
+
+		bool ParseObjectProperties(
+			const pugi::xml_node& objectNode,
+			std::vector<ObjectGroup::property_type>& propertiesOut)
+		{
+			const auto first(propertiesOut.size());
+			for (const auto& propertiesNode : objectNode.children("properties"))
+			{
+				for (const auto& propertyNode : propertiesNode.children("property"))
+				{
+					ObjectGroup::property_type property;
+					if (!property.Parse(propertyNode))
+					{
+						return false;
+					}
+
+					//	Later definitions replace earlier ones
+					const auto existing(std::find_if(
+						propertiesOut.begin() + first,
+						propertiesOut.end(),
+						[&property](const ObjectGroup::property_type& other)
+						{
+							return other.GetInternedName() == property.GetInternedName();
+						}));
+					if (existing != propertiesOut.end())
+					{
+						*existing = std::move(property);
+					}
+					else
+					{
+						propertiesOut.emplace_back(std::move(property));
+					}
+				}
+			}
+
+			SortObjectProperties(propertiesOut.begin() + first, propertiesOut.end());
+
+			return true;
+		}
+
+	}
+
+
+
+
+	//	Empty groups share a single storage so default construction is cheap
+	ObjectGroup::ObjectGroup()
+	{
+		static const std::shared_ptr<const Storage> emptyStorage(std::make_shared<Storage>());
+		m_Storage = emptyStorage;
+	}
+
+
+	bool ObjectGroup::Parse(const pugi::xml_node& objectGroupNode)
+	{
+		auto storage(std::make_shared<Storage>());
+		storage->propertyOffsets.push_back(0);
+
+		for (const auto& objectNode : objectGroupNode.children("object"))
 		{
-			std::vector<Type_> clonedObjects;
-			transform(
-				objects.begin(),
-				objects.end(),
-				back_inserter(clonedObjects),
-				[](const Type_& ptr) -> Type_ { return ptr->Clone(); }
-			);
-
-			return move(clonedObjects);
+			const auto& nameAttr(objectNode.attribute("name"));
+			if (nameAttr.empty())
+			{
+				std::cerr << "WARNING: Object does not have a name attribute\n";
+			}
+
+			const auto& typeAttr(objectNode.attribute("type"));
+			if (!typeAttr.empty() && !*typeAttr.as_string())
+			{
+				std::cerr << "Object group has an empty type attribute\n";
+				return false;
+			}
+
+			const auto& xPosAttr(objectNode.attribute("x"));
+			if (xPosAttr.empty())
+			{
+				std::cerr << "Object group does not have a x position attribute\n";
+				return false;
+			}
+
+			const auto& yPosAttr(objectNode.attribute("y"));
+			if (yPosAttr.empty())
+			{
+				std::cerr << "Object group does not have a y position attribute\n";
+				return false;
+			}
+
+			if (!ParseObjectProperties(objectNode, storage->properties))
+			{
+				return false;
+			}
+
+			storage->ids.push_back(objectNode.attribute("id").as_uint());
+			storage->xPositions.push_back(xPosAttr.as_int());
+			storage->yPositions.push_back(yPosAttr.as_int());
+			storage->names.emplace_back(nameAttr.as_string());
+			storage->types.emplace_back(typeAttr.as_string());
+			storage->propertyOffsets.push_back(static_cast<uint32_t>(storage->properties.size()));
 		}
+
+		m_Storage = move(storage);
+
+		return true;
 	}
 
 
-	ObjectGroup::ObjectGroup(const ObjectGroup& other)
-		: m_Objects(CloneVector<value_type>(other.m_Objects))
-	{}
 
-	ObjectGroup& ObjectGroup::operator=(const ObjectGroup& other)
+
+	void ObjectGroup::Serialize(BinaryWriter& writer) const
 	{
-		if (this != &other)
+		writer.Write(m_Storage->ids);
+		writer.Write(m_Storage->xPositions);
+		writer.Write(m_Storage->yPositions);
+		for (auto i(0U); i < m_Storage->ids.size(); ++i)
 		{
-			operator=(ObjectGroup(other));
+			writer.Write(m_Storage->names[i].str());
+			writer.Write(m_Storage->types[i].str());
 		}
 
-		return *this;
+		writer.Write(m_Storage->propertyOffsets);
+		writer.Write(static_cast<uint64_t>(m_Storage->properties.size()));
+
+		//	Properties are kept in interned id order for lookups but written
+		//	by name so the output is the same in every process.
+		std::vector<const property_type*> properties;
+		for (auto i(0U); i < m_Storage->ids.size(); ++i)
+		{
+			properties.clear();
+			const auto first(m_Storage->properties.begin() + m_Storage->propertyOffsets[i]);
+			const auto last(m_Storage->properties.begin() + m_Storage->propertyOffsets[i + 1]);
+			for (auto property(first); property != last; ++property)
+			{
+				properties.push_back(&*property);
+			}
+
+			std::sort(properties.begin(), properties.end(), [](const property_type* lhs, const property_type* rhs)
+			{
+				return lhs->GetName() < rhs->GetName();
+			});
+
+			for (const auto property : properties)
+			{
+				property->Serialize(writer);
+			}
+		}
 	}
 
-	bool ObjectGroup::Parse(const pugi::xml_node& objectGroupNode)
+
+	bool ObjectGroup::Deserialize(BinaryReader& reader)
 	{
-		container_type objects;
-		for (const auto& objectNode : objectGroupNode.children("object"))
+		auto storage(std::make_shared<Storage>());
+		if (   !reader.Read(storage->ids)
+			|| !reader.Read(storage->xPositions)
+			|| !reader.Read(storage->yPositions)
+			|| storage->xPositions.size() != storage->ids.size()
+			|| storage->yPositions.size() != storage->ids.size())
+		{
+			return false;
+		}
+
+		const auto objectCount(storage->ids.size());
+		storage->names.reserve(objectCount);
+		storage->types.reserve(objectCount);
+		for (auto i(0U); i < objectCount; ++i)
+		{
+			std::string name, type;
+			if (!reader.Read(name) || !reader.Read(type))
+			{
+				return false;
+			}
+
+			storage->names.emplace_back(name);
+			storage->types.emplace_back(type);
+		}
+
+		uint64_t propertyCount;
+		if (   !reader.Read(storage->propertyOffsets)
+			|| !reader.Read(propertyCount)
+			|| storage->propertyOffsets.size() != objectCount + 1
+			|| storage->propertyOffsets.front() != 0
+			|| storage->propertyOffsets.back() != propertyCount
+			|| !std::is_sorted(storage->propertyOffsets.begin(), storage->propertyOffsets.end()))
 		{
-			auto object(std::make_shared<Object>());
-			if (!object->Parse(objectNode))
+			return false;
+		}
+
+		storage->properties.resize(static_cast<size_t>(propertyCount));
+		for (auto& property : storage->properties)
+		{
+			if (!property.Deserialize(reader))
 			{
 				return false;
 			}
+		}
 
-			objects.emplace_back(std::move(object));
+		for (auto i(0U); i < objectCount; ++i)
+		{
+			SortObjectProperties(
+				storage->properties.begin() + storage->propertyOffsets[i],
+				storage->properties.begin() + storage->propertyOffsets[i + 1]);
 		}
 
-		m_Objects = move(objects);
+		m_Storage = move(storage);
 
 		return true;
 	}
@@ -67,25 +241,107 @@ namespace KAOS { namespace Tiled
 
 
 
-	ObjectGroup::container_type::size_type ObjectGroup::size() const
+	ObjectGroup::size_type ObjectGroup::size() const
 	{
-		return m_Objects.size();
+		return m_Storage->ids.size();
 	}
 
 
 	ObjectGroup::const_iterator ObjectGroup::begin() const
 	{
-		return m_Objects.cbegin();
+		return const_iterator(*m_Storage, 0);
 	}
 
 
 	ObjectGroup::const_iterator ObjectGroup::end() const
 	{
-		return m_Objects.cend();
+		return const_iterator(*m_Storage, size());
+	}
+
+
+	ObjectGroup::ObjectView ObjectGroup::operator[](size_type index) const
+	{
+		return ObjectView(*m_Storage, index);
+	}
+
+
+
+
+	ObjectGroup::id_type ObjectGroup::ObjectView::GetId() const
+	{
+		return m_Storage->ids[m_Index];
+	}
+
+
+	const std::string& ObjectGroup::ObjectView::GetName() const
+	{
+		return m_Storage->names[m_Index];
+	}
+
+
+	const std::string& ObjectGroup::ObjectView::GetType() const
+	{
+		return m_Storage->types[m_Index];
 	}
 
-}}
 
+	const InternedString& ObjectGroup::ObjectView::GetInternedName() const
+	{
+		return m_Storage->names[m_Index];
+	}
+
+
+	const InternedString& ObjectGroup::ObjectView::GetInternedType() const
+	{
+		return m_Storage->types[m_Index];
+	}
+
+
+	int ObjectGroup::ObjectView::GetXPos() const
+	{
+		return m_Storage->xPositions[m_Index];
+	}
+
+
+	int ObjectGroup::ObjectView::GetYPos() const
+	{
+		return m_Storage->yPositions[m_Index];
+	}
+
+
+	std::optional<ObjectGroup::property_type> ObjectGroup::ObjectView::QueryProperty(const std::string& name) const
+	{
+		const auto property(FindProperty(name));
+
+		return property ? *property : std::optional<property_type>();
+	}
+
+
+	const ObjectGroup::property_type* ObjectGroup::ObjectView::FindProperty(const std::string& name) const
+	{
+		const auto key(InternedString::Find(name));
+
+		return key.has_value() ? FindProperty(*key) : nullptr;
+	}
+
+
+	const ObjectGroup::property_type* ObjectGroup::ObjectView::FindProperty(const InternedString& name) const
+	{
+		const auto first(m_Storage->properties.begin() + m_Storage->propertyOffsets[m_Index]);
+		const auto last(m_Storage->properties.begin() + m_Storage->propertyOffsets[m_Index + 1]);
+		const auto property(std::lower_bound(
+			first,
+			last,
+			name.GetId(),
+			[](const property_type& property, InternedString::id_type id)
+			{
+				return property.GetInternedName().GetId() < id;
+			}));
+
+		return property != last && property->GetInternedName() == name ? &*property : nullptr;
+	}
+
+}}
 
 
 
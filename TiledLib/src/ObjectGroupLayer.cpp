@@ -26,28 +26,106 @@ namespace KAOS { namespace Tiled
 		}
 
 
+		m_ObjectGroupNode = pugi::xml_node();
+		m_Source.reset();
 		m_ObjectGroup = std::move(objectGroup);
+		m_IsParsed = true;
 
 		return true;
 	}
 
 
+	bool ObjectGroupLayer::ParseDeferred(const pugi::xml_node& objectGroupNode, source_type source)
+	{
+		if (!Layer::Parse(objectGroupNode))
+		{
+			return false;
+		}
+
+		m_ObjectGroupNode = objectGroupNode;
+		m_Source = move(source);
+		m_ObjectGroup = ObjectGroup();
+		m_IsParsed = false;
+
+		return true;
+	}
+
+
+	void ObjectGroupLayer::Serialize(BinaryWriter& writer) const
+	{
+		Layer::Serialize(writer);
+		if (m_IsParsed)
+		{
+			m_ObjectGroup.Serialize(writer);
+			return;
+		}
+
+		//	Parse into a temporary so writing a snapshot does not leave the
+		//	objects of every deferred layer resident.
+		ObjectGroup objectGroup;
+		if (!objectGroup.Parse(m_ObjectGroupNode))
+		{
+			std::cerr << "Unable to parse objects for layer `" << GetName() << "`\n";
+			objectGroup = ObjectGroup();
+		}
+
+		objectGroup.Serialize(writer);
+	}
+
+
+	bool ObjectGroupLayer::Deserialize(BinaryReader& reader)
+	{
+		ObjectGroup objectGroup;
+		if (!Layer::Deserialize(reader) || !objectGroup.Deserialize(reader))
+		{
+			return false;
+		}
+
+		m_ObjectGroupNode = pugi::xml_node();
+		m_Source.reset();
+		m_ObjectGroup = std::move(objectGroup);
+		m_IsParsed = true;
+
+		return true;
+	}
+
+
+	void ObjectGroupLayer::EnsureParsed() const
+	{
+		if (m_IsParsed)
+		{
+			return;
+		}
+
+		if (!m_ObjectGroup.Parse(m_ObjectGroupNode))
+		{
+			std::cerr << "Unable to parse objects for layer `" << GetName() << "`\n";
+		}
+
+		m_IsParsed = true;
+		m_Source.reset();
+	}
+
+
 
 
 	ObjectGroupLayer::size_type ObjectGroupLayer::size() const
 	{
+		EnsureParsed();
 		return m_ObjectGroup.size();
 	}
 
 
 	ObjectGroupLayer::const_iterator ObjectGroupLayer::begin() const
 	{
+		EnsureParsed();
 		return m_ObjectGroup.begin();
 	}
 
 
 	ObjectGroupLayer::const_iterator ObjectGroupLayer::end() const
 	{
+		EnsureParsed();
 		return m_ObjectGroup.end();
 	}
 
@@ -6,7 +6,9 @@
 //	of this file.
 #include <Tiled/PropertyBag.h>
 #include <KAOS/Common/Utilities.h>
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 
 namespace KAOS { namespace Tiled
@@ -24,7 +26,57 @@ namespace KAOS { namespace Tiled
 				return false;
 			}
 
-			properties[property.GetName()] = std::move(property);
+			properties[property.GetInternedName()] = std::move(property);
+		}
+
+		m_Properties = move(properties);
+
+		return true;
+	}
+
+
+	void PropertyBag::Serialize(BinaryWriter& writer) const
+	{
+		//	Hash order depends on where names were interned so properties are
+		//	written by name to keep snapshots and caches byte-stable.
+		std::vector<const value_type*> properties;
+		properties.reserve(m_Properties.size());
+		for (const auto& property : m_Properties)
+		{
+			properties.push_back(&property.second);
+		}
+
+		std::sort(properties.begin(), properties.end(), [](const value_type* lhs, const value_type* rhs)
+		{
+			return lhs->GetName() < rhs->GetName();
+		});
+
+		writer.Write(static_cast<uint32_t>(properties.size()));
+		for (const auto property : properties)
+		{
+			property->Serialize(writer);
+		}
+	}
+
+
+	bool PropertyBag::Deserialize(BinaryReader& reader)
+	{
+		uint32_t count;
+		if (!reader.Read(count))
+		{
+			return false;
+		}
+
+		container_type properties;
+		for (auto i(0U); i < count; ++i)
+		{
+			NamedProperty property;
+			if (!property.Deserialize(reader))
+			{
+				return false;
+			}
+
+			properties[property.GetInternedName()] = std::move(property);
 		}
 
 		m_Properties = move(properties);
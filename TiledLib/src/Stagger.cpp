@@ -71,6 +71,31 @@ namespace KAOS { namespace Tiled
 
 
 
+	void Stagger::Serialize(BinaryWriter& writer) const
+	{
+		writer.Write(m_Axis);
+		writer.Write(m_Index);
+	}
+
+
+	bool Stagger::Deserialize(BinaryReader& reader)
+	{
+		Axis axis;
+		Index index;
+		if (!reader.Read(axis) || !reader.Read(index))
+		{
+			return false;
+		}
+
+		m_Axis = axis;
+		m_Index = index;
+
+		return true;
+	}
+
+
+
+
 	Stagger::Axis Stagger::GetAxis() const
 	{
 		return m_Axis;
@@ -31,10 +31,10 @@ namespace KAOS { namespace Tiled
 		}
 
 
-		std::string type(typeAttr.as_string());
+		InternedString type(typeAttr.as_string());
 
 		m_Id = idAttr.as_uint();
-		m_Type = move(type);
+		m_Type = type;
 		m_Probability = probabilityAttr.as_float(1.0f);
 		m_AnimationFrames = move(animationFrames);
 		m_Properties = std::move(propertyBag);
@@ -43,6 +43,57 @@ namespace KAOS { namespace Tiled
 	}
 
 
+	void Tile::Serialize(BinaryWriter& writer) const
+	{
+		writer.Write(m_Id);
+		writer.Write(m_Type.str());
+		writer.Write(m_Probability);
+		writer.Write(static_cast<uint32_t>(m_AnimationFrames.size()));
+		for (const auto& frame : m_AnimationFrames)
+		{
+			frame.Serialize(writer);
+		}
+
+		m_Properties.Serialize(writer);
+	}
+
+
+	bool Tile::Deserialize(BinaryReader& reader)
+	{
+		id_type id;
+		std::string type;
+		float_t probability;
+		uint32_t frameCount;
+		if (!reader.Read(id) || !reader.Read(type) || !reader.Read(probability) || !reader.Read(frameCount))
+		{
+			return false;
+		}
+
+		frame_container animationFrames(frameCount);
+		for (auto& frame : animationFrames)
+		{
+			if (!frame.Deserialize(reader))
+			{
+				return false;
+			}
+		}
+
+		PropertyBag propertyBag;
+		if (!propertyBag.Deserialize(reader))
+		{
+			return false;
+		}
+
+		m_Id = id;
+		m_Type = InternedString(type);
+		m_Probability = probability;
+		m_AnimationFrames = move(animationFrames);
+		m_Properties = std::move(propertyBag);
+
+		return true;
+	}
+
+
 	bool Tile::ParseChildren(
 		const pugi::xml_node& rootNode,
 		frame_container& animationFramesOut,
@@ -119,7 +170,7 @@ namespace KAOS { namespace Tiled
 	}
 
 
-	std::string Tile::GetType() const
+	const std::string& Tile::GetType() const
 	{
 		return m_Type;
 	}
@@ -131,17 +182,29 @@ namespace KAOS { namespace Tiled
 	}
 
 
-	Tile::frame_container Tile::GetAnimationFrames() const
+	const Tile::frame_container& Tile::GetAnimationFrames() const
 	{
 		return m_AnimationFrames;
 	}
 
 
+	const PropertyBag& Tile::GetProperties() const
+	{
+		return m_Properties;
+	}
+
+
 	std::optional<PropertyBag::value_type> Tile::QueryProperty(const std::string& name) const
 	{
 		return m_Properties.find(name);
 	}
 
+
+	const PropertyBag::value_type* Tile::FindProperty(const std::string& name) const
+	{
+		return m_Properties.lookup(name);
+	}
+
 }}
 
 
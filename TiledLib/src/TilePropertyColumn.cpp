@@ -0,0 +1,212 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#include <Tiled/TilePropertyColumn.h>
+
+
+namespace KAOS { namespace Tiled
+{
+
+	namespace
+	{
+
+		using Property = KAOS::Common::Property;
+		using mixed_container_type = std::vector<Property>;
+
+
+		TilePropertyColumn::storage_type MakeStorage(TilePropertyColumn::type_id type, size_t tileCount)
+		{
+			switch (type)
+			{
+			case TilePropertyColumn::type_id::Boolean:
+				return std::vector<Property::bool_type>(tileCount);
+
+			case TilePropertyColumn::type_id::Integer:
+				return std::vector<Property::int_type>(tileCount);
+
+			case TilePropertyColumn::type_id::Float:
+				return std::vector<Property::float_type>(tileCount);
+
+			case TilePropertyColumn::type_id::Color:
+				return std::vector<Property::color_type>(tileCount);
+
+			default:
+				return std::vector<Property::string_type>(tileCount);
+			}
+		}
+
+
+		Property MakeDefaultValue(TilePropertyColumn::type_id type)
+		{
+			switch (type)
+			{
+			case TilePropertyColumn::type_id::Boolean:
+				return Property(Property::bool_type());
+
+			case TilePropertyColumn::type_id::Integer:
+				return Property(Property::int_type());
+
+			case TilePropertyColumn::type_id::Float:
+				return Property(Property::float_type());
+
+			case TilePropertyColumn::type_id::Color:
+				return Property(Property::color_type());
+
+			default:
+				return Property(Property::string_type());
+			}
+		}
+
+	}
+
+
+	TilePropertyColumn::TilePropertyColumn(InternedString name, type_id type, size_t tileCount)
+		:
+		m_Name(name),
+		m_Type(type),
+		m_Values(MakeStorage(type, tileCount)),
+		m_IsPresent(tileCount, false)
+	{}
+
+
+	const std::string& TilePropertyColumn::GetName() const
+	{
+		return m_Name;
+	}
+
+
+	const InternedString& TilePropertyColumn::GetInternedName() const
+	{
+		return m_Name;
+	}
+
+
+	bool TilePropertyColumn::IsTyped() const
+	{
+		return !std::holds_alternative<mixed_container_type>(m_Values);
+	}
+
+
+	TilePropertyColumn::type_id TilePropertyColumn::GetType() const
+	{
+		return m_Type;
+	}
+
+
+	std::optional<TilePropertyColumn::value_type> TilePropertyColumn::find(id_type tileId) const
+	{
+		return HasValue(tileId) ? (*this)[tileId] : std::optional<value_type>();
+	}
+
+
+	TilePropertyColumn::value_type TilePropertyColumn::operator[](id_type tileId) const
+	{
+		if (tileId >= size())
+		{
+			return value_type(m_Name, MakeDefaultValue(m_Type));
+		}
+
+		return std::visit([this, tileId](const auto& values)
+		{
+			using element_type = typename std::decay_t<decltype(values)>::value_type;
+
+			return value_type(m_Name, Property(static_cast<element_type>(values[tileId])));
+		},
+		m_Values);
+	}
+
+
+	void TilePropertyColumn::Set(id_type tileId, const Property& value)
+	{
+		if (tileId >= size())
+		{
+			std::visit([tileId](auto& values) { values.resize(tileId + 1); }, m_Values);
+			m_IsPresent.resize(tileId + 1, false);
+		}
+
+		//	A value of another type turns the column into a list of properties
+		//	so no tile loses its value.
+		if (IsTyped() && value.GetType() != m_Type)
+		{
+			mixed_container_type values;
+			values.reserve(size());
+			for (auto i(0U); i < size(); ++i)
+			{
+				values.push_back((*this)[i]);
+			}
+
+			m_Values = move(values);
+		}
+
+		std::visit([tileId, &value](auto& values)
+		{
+			using element_type = typename std::decay_t<decltype(values)>::value_type;
+
+			if constexpr (std::is_same_v<element_type, Property>)
+			{
+				values[tileId] = value;
+			}
+			else
+			{
+				element_type typedValue;
+				value.QueryValue(typedValue);
+				values[tileId] = typedValue;
+			}
+		},
+		m_Values);
+
+		m_IsPresent[tileId] = true;
+	}
+
+
+	size_t TilePropertyColumn::EstimateMemoryUsage() const
+	{
+		auto usage(sizeof(TilePropertyColumn) + m_IsPresent.size() / 8);
+		std::visit([&usage](const auto& values)
+		{
+			using element_type = typename std::decay_t<decltype(values)>::value_type;
+
+			usage += values.size() * sizeof(element_type);
+			if constexpr (std::is_same_v<element_type, Property::string_type>)
+			{
+				for (const auto& value : values)
+				{
+					usage += value.capacity();
+				}
+			}
+		},
+		m_Values);
+
+		return usage;
+	}
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
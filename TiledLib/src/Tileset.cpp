@@ -6,6 +6,7 @@
 //	of this file.
 #include <Tiled/Tileset.h>
 #include <KAOS/Common/Utilities.h>
+#include <KAOS/Common/xml.h>
 #include <iostream>
 
 
@@ -14,17 +15,15 @@ namespace KAOS { namespace Tiled
 
 	bool Tileset::Load(std::string filepath)
 	{
-		pugi::xml_document doc;
-
-		auto result(doc.load_file(filepath.c_str()));
-		if (!result)
+		Common::XML::MappedDocument document;
+		if (!document.Load(filepath))
 		{
 			std::cerr << "Unable to open `" << filepath << "`\n";
 			return false;
 		}
 
 
-		auto mapNode(doc.child("tileset"));
+		auto mapNode(document.GetDocument().child("tileset"));
 		if (mapNode.empty())
 		{
 			std::cerr << "File does not appear to contain a tileset\n";
@@ -101,12 +100,118 @@ namespace KAOS { namespace Tiled
 		m_Properties = std::move(properties);
 		m_TilesetImage = std::move(tilesetImage);
 		m_TileDefinitions = move(tileDefinitions);
+		BuildTilePropertyColumns();
+
+
+		return true;
+	}
+
+
+
+	void Tileset::Serialize(BinaryWriter& writer) const
+	{
+		writer.Write(m_Filepath);
+		writer.Write(m_Filename);
+		writer.Write(m_Directory);
+		writer.Write(m_Name);
+		writer.Write(m_TileDimensions.GetWidth());
+		writer.Write(m_TileDimensions.GetHeight());
+		writer.Write(static_cast<uint64_t>(m_TileCount));
+		writer.Write(static_cast<uint64_t>(m_Columns));
+		writer.Write(static_cast<uint64_t>(m_Margin));
+		writer.Write(static_cast<uint64_t>(m_Spacing));
+		m_TilesetImage.Serialize(writer);
+		m_Properties.Serialize(writer);
+
+		writer.Write(static_cast<uint64_t>(m_TileDefinitions.size()));
+		for (const auto& tile : m_TileDefinitions)
+		{
+			tile.second.Serialize(writer);
+		}
+	}
+
+
+	bool Tileset::Deserialize(BinaryReader& reader)
+	{
+		std::string filepath, filename, directory, name;
+		Size::value_type tileWidth, tileHeight;
+		uint64_t tileCount, columns, margin, spacing;
+		if (   !reader.Read(filepath)
+			|| !reader.Read(filename)
+			|| !reader.Read(directory)
+			|| !reader.Read(name)
+			|| !reader.Read(tileWidth)
+			|| !reader.Read(tileHeight)
+			|| !reader.Read(tileCount)
+			|| !reader.Read(columns)
+			|| !reader.Read(margin)
+			|| !reader.Read(spacing))
+		{
+			return false;
+		}
 
+		TilesetImage tilesetImage;
+		PropertyBag properties;
+		uint64_t tileDefinitionCount;
+		if (!tilesetImage.Deserialize(reader) || !properties.Deserialize(reader) || !reader.Read(tileDefinitionCount))
+		{
+			return false;
+		}
+
+		tile_collection_type tileDefinitions;
+		for (auto i(0ULL); i < tileDefinitionCount; ++i)
+		{
+			Tile tile;
+			if (!tile.Deserialize(reader))
+			{
+				return false;
+			}
+
+			const auto id(tile.GetId());
+			tileDefinitions.emplace(id, std::move(tile));
+		}
+
+		m_Filepath = move(filepath);
+		m_Filename = move(filename);
+		m_Directory = move(directory);
+		m_Name = move(name);
+		m_TileDimensions = Size(static_cast<unsigned int>(tileWidth), static_cast<unsigned int>(tileHeight));
+		m_TileCount = static_cast<size_t>(tileCount);
+		m_Columns = static_cast<size_t>(columns);
+		m_Margin = static_cast<size_t>(margin);
+		m_Spacing = static_cast<size_t>(spacing);
+		m_Properties = std::move(properties);
+		m_TilesetImage = std::move(tilesetImage);
+		m_TileDefinitions = move(tileDefinitions);
+		BuildTilePropertyColumns();
 
 		return true;
 	}
 
 
+	void Tileset::BuildTilePropertyColumns()
+	{
+		property_column_collection_type columns;
+		for (const auto& tile : m_TileDefinitions)
+		{
+			for (const auto& property : tile.second.GetProperties())
+			{
+				auto column(columns.find(property.first));
+				if (column == columns.end())
+				{
+					column = columns.emplace(
+						property.first,
+						TilePropertyColumn(property.first, property.second.GetType(), m_TileCount)).first;
+				}
+
+				column->second.Set(tile.first, property.second);
+			}
+		}
+
+		m_TilePropertyColumns = move(columns);
+	}
+
+
 	bool Tileset::ParseChildren(
 		const pugi::xml_node& rootNode,
 		tile_collection_type& tileDefinitionsOut,
@@ -163,25 +268,25 @@ namespace KAOS { namespace Tiled
 
 
 
-	std::string Tileset::GetFilePath() const
+	const std::string& Tileset::GetFilePath() const
 	{
 		return m_Filepath;
 	}
 
 
-	std::string Tileset::GetFilename() const
+	const std::string& Tileset::GetFilename() const
 	{
 		return m_Filename;
 	}
 
 
-	std::string Tileset::GetDirectory() const
+	const std::string& Tileset::GetDirectory() const
 	{
 		return m_Directory;
 	}
 
 
-	std::string Tileset::GetName() const
+	const std::string& Tileset::GetName() const
 	{
 		return m_Name;
 	}
@@ -217,13 +322,13 @@ namespace KAOS { namespace Tiled
 	}
 
 
-	TilesetImage Tileset::GetImage() const
+	const TilesetImage& Tileset::GetImage() const
 	{
 		return m_TilesetImage;
 	}
 
 
-	Tileset::tile_collection_type Tileset::GetTiles() const
+	const Tileset::tile_collection_type& Tileset::GetTiles() const
 	{
 		return m_TileDefinitions;
 	}
@@ -234,6 +339,55 @@ namespace KAOS { namespace Tiled
 		return m_Properties.find(name);
 	}
 
+
+	const PropertyBag::value_type* Tileset::FindProperty(const std::string& name) const
+	{
+		return m_Properties.lookup(name);
+	}
+
+
+	const TilePropertyColumn* Tileset::FindTilePropertyColumn(const std::string& name) const
+	{
+		const auto key(InternedString::Find(name));
+
+		return key.has_value() ? FindTilePropertyColumn(*key) : nullptr;
+	}
+
+
+	const TilePropertyColumn* Tileset::FindTilePropertyColumn(const InternedString& name) const
+	{
+		const auto column(m_TilePropertyColumns.find(name));
+
+		return column != m_TilePropertyColumns.end() ? &column->second : nullptr;
+	}
+
+
+	size_t Tileset::EstimateMemoryUsage() const
+	{
+		//	Rough allowance for the bookkeeping of each map and hash node
+		static const size_t NodeOverhead = 4 * sizeof(void*);
+
+		size_t usage(sizeof(Tileset));
+		usage += m_Filepath.capacity() + m_Filename.capacity() + m_Directory.capacity() + m_Name.capacity();
+		usage += m_TilesetImage.GetSource().capacity();
+		usage += m_Properties.size() * (sizeof(PropertyBag::container_type::value_type) + NodeOverhead);
+
+		for (const auto& tile : m_TileDefinitions)
+		{
+			usage += sizeof(tile_collection_type::value_type) + NodeOverhead;
+			usage += tile.second.GetAnimationFrames().capacity() * sizeof(AnimationFrame);
+			usage += tile.second.GetProperties().size() * (sizeof(PropertyBag::container_type::value_type) + NodeOverhead);
+		}
+
+		for (const auto& column : m_TilePropertyColumns)
+		{
+			usage += sizeof(InternedString) + NodeOverhead;
+			usage += column.second.EstimateMemoryUsage();
+		}
+
+		return usage;
+	}
+
 }}
 
 
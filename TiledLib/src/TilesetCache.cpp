@@ -5,36 +5,308 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #include <Tiled/TilesetCache.h>
+#include <Tiled/CacheFile.h>
+#include <KAOS/Common/MappedFile.h>
 #include <KAOS/Common/Utilities.h>
+#include <filesystem>
 #include <iostream>
 
 
 namespace KAOS { namespace Tiled
 {
 
+	namespace
+	{
+
+		const uint32_t CacheSignature = 0x4353544b;	//	"KTSC"
+		const uint32_t CacheVersion = 1;
+
+
+		//	Paths that reach the same file through links share a key where the
+		//	platform can identify files
+		std::string MakeCacheKey(const std::string& canonicalFilepath)
+		{
+			const auto identity(Common::QueryFileIdentity(canonicalFilepath));
+			if (!identity.has_value())
+			{
+				return canonicalFilepath;
+			}
+
+			return "inode:" + Common::to_hex_string(identity->device, 16) + ":" + Common::to_hex_string(identity->inode, 16);
+		}
+
+
+		std::string GetCacheFilepath(const std::string& cacheDirectory, const SourceKey& key)
+		{
+			return Common::MakePath(cacheDirectory, Common::to_hex_string(HashBytes(key.path.data(), key.path.size()), 16) + ".tsc");
+		}
+
+
+		void WriteHeader(BinaryWriter& writer, const SourceKey& key)
+		{
+			writer.Write(CacheSignature);
+			writer.Write(CacheVersion);
+			key.Serialize(writer);
+		}
+
+
+		bool ReadHeader(BinaryReader& reader, const SourceKey& key)
+		{
+			uint32_t signature, version;
+			SourceKey cachedKey;
+
+			return reader.Read(signature) && signature == CacheSignature
+				&& reader.Read(version) && version == CacheVersion
+				&& cachedKey.Deserialize(reader) && cachedKey == key;
+		}
+
+
+		std::shared_ptr<Tileset> LoadCachedTileset(const std::string& cacheFilepath, const SourceKey& key)
+		{
+			Common::MappedFile file;
+			if (!file.Open(cacheFilepath))
+			{
+				return nullptr;
+			}
+
+			BinaryReader reader(file.data(), file.size());
+			if (!ReadHeader(reader, key))
+			{
+				return nullptr;
+			}
+
+			auto tileset(std::make_shared<Tileset>());
+			if (!tileset->Deserialize(reader) || !reader.IsAtEnd())
+			{
+				std::cerr << "WARNING: Ignoring corrupt tileset cache entry `" << cacheFilepath << "`\n";
+				return nullptr;
+			}
+
+			return tileset;
+		}
+
+
+		void StoreCachedTileset(const std::string& cacheFilepath, const SourceKey& key, const Tileset& tileset)
+		{
+			BinaryWriter writer;
+			WriteHeader(writer, key);
+			tileset.Serialize(writer);
+
+			if (!WriteCacheFile(cacheFilepath, writer))
+			{
+				std::cerr << "WARNING: Unable to write tileset cache entry `" << cacheFilepath << "`\n";
+			}
+		}
+
+	}
+
+
+
+
+	TilesetCache::TilesetCache(std::string cacheDirectory)
+		: m_CacheDirectory(move(cacheDirectory))
+	{
+		std::error_code error;
+		std::filesystem::create_directories(m_CacheDirectory, error);
+		if (error)
+		{
+			std::cerr << "WARNING: Unable to create tileset cache directory `" << m_CacheDirectory << "`. Tileset caching disabled.\n";
+			m_CacheDirectory.clear();
+		}
+	}
+
+
 	std::optional<TilesetCache::value_type> TilesetCache::Load(const std::string& filepath)
 	{
-		//	FIXME: We should "clean" the path
 		if (!Common::IsAbsolutePath(filepath))
 		{
 			std::cerr << "Retrieving a cached tileset requires an absolute path\n";
 			return std::optional<TilesetCache::value_type>();
 		}
 
+		//	Links only affect the cache key. The tileset is loaded from the
+		//	path it was requested with so relative image sources resolve from
+		//	the directory the caller refers to rather than the link target's.
+		const auto normalizedFilepath(Common::EnsureAbsolutePath(filepath));
+		const auto key(MakeCacheKey(Common::CanonicalizePath(filepath)));
+
+
+		std::promise<value_type> loadedTileset;
+		future_type tileset;
+		bool isLoader(false);
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			auto cachedTileset(m_Cache.find(key));
+			if (cachedTileset != m_Cache.end())
+			{
+				auto& entry(cachedTileset->second);
+				m_UsageOrder.splice(m_UsageOrder.begin(), m_UsageOrder, entry.usagePosition);
+				tileset = entry.tileset;
+				++m_Statistics.hits;
+			}
+			else
+			{
+				Entry entry;
+				entry.tileset = loadedTileset.get_future().share();
+				entry.usagePosition = m_UsageOrder.insert(m_UsageOrder.begin(), key);
+				tileset = entry.tileset;
+				m_Cache.emplace(key, std::move(entry));
+				++m_Statistics.misses;
+				isLoader = true;
+			}
+		}
+
+		//	Load outside of the lock so other tilesets can load in parallel
+		if (!isLoader)
+		{
+			return tileset.get();
+		}
+
+		value_type result;
+		try
+		{
+			result = LoadTileset(normalizedFilepath);
+			loadedTileset.set_value(result);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(m_Mutex);
+
+			const auto entry(m_Cache.find(key));
+			m_UsageOrder.erase(entry->second.usagePosition);
+			m_Cache.erase(entry);
+			loadedTileset.set_exception(std::current_exception());
+			throw;
+		}
+
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		//	Failed loads are not cached so the next request tries again.
+		//	Callers already waiting on the entry still receive the failure.
+		const auto cachedTileset(m_Cache.find(key));
+		if (!result)
+		{
+			m_UsageOrder.erase(cachedTileset->second.usagePosition);
+			m_Cache.erase(cachedTileset);
+			return result;
+		}
 
-		auto cachedTileset(m_Cache.find(filepath));
-		if (cachedTileset != m_Cache.end())
+		//	`result` keeps the new tileset pinned while making room for it
+		auto& entry(cachedTileset->second);
+		entry.isLoaded = true;
+		entry.memoryUsage = result->EstimateMemoryUsage();
+		m_Statistics.memoryUsage += entry.memoryUsage;
+		EvictLeastRecentlyUsed();
+
+		return result;
+	}
+
+
+	bool TilesetCache::Preload(const std::vector<std::string>& filepaths)
+	{
+		std::vector<std::future<bool>> loads;
+		loads.reserve(filepaths.size());
+		for (const auto& filepath : filepaths)
 		{
-			return cachedTileset->second;
+			loads.emplace_back(std::async(std::launch::async, [this, &filepath]() -> bool
+			{
+				const auto tileset(Load(filepath));
+				return tileset.has_value() && *tileset;
+			}));
+		}
+
+		bool result(true);
+		for (auto& load : loads)
+		{
+			result = load.get() && result;
+		}
+
+		return result;
+	}
+
+
+	void TilesetCache::SetMemoryBudget(size_t bytes)
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		m_MemoryBudget = bytes;
+		EvictLeastRecentlyUsed();
+	}
+
+
+	size_t TilesetCache::GetMemoryBudget() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		return m_MemoryBudget;
+	}
+
+
+	TilesetCache::Statistics TilesetCache::GetStatistics() const
+	{
+		std::lock_guard<std::mutex> lock(m_Mutex);
+
+		return m_Statistics;
+	}
+
+
+	void TilesetCache::EvictLeastRecentlyUsed()
+	{
+		if (m_MemoryBudget == 0)
+		{
+			return;
+		}
+
+		auto position(m_UsageOrder.end());
+		while (m_Statistics.memoryUsage > m_MemoryBudget && position != m_UsageOrder.begin())
+		{
+			--position;
+
+			const auto entry(m_Cache.find(*position));
+			const auto& tileset(entry->second.tileset);
+
+			//	Tilesets that are still loading or in use elsewhere stay cached
+			if (!entry->second.isLoaded || tileset.get().use_count() > 1)
+			{
+				continue;
+			}
+
+			m_Statistics.memoryUsage -= entry->second.memoryUsage;
+			++m_Statistics.evictions;
+			m_Cache.erase(entry);
+			position = m_UsageOrder.erase(position);
+		}
+	}
+
+
+	TilesetCache::value_type TilesetCache::LoadTileset(const std::string& filepath) const
+	{
+		std::optional<SourceKey> sourceKey;
+		std::string cacheFilepath;
+		if (!m_CacheDirectory.empty())
+		{
+			sourceKey = SourceKey::Query(filepath);
+			if (sourceKey.has_value())
+			{
+				cacheFilepath = GetCacheFilepath(m_CacheDirectory, *sourceKey);
+				if (auto tileset = LoadCachedTileset(cacheFilepath, *sourceKey))
+				{
+					return tileset;
+				}
+			}
 		}
 
 		auto tileset(std::make_shared<Tileset>());
 		if (!tileset->Load(filepath))
 		{
-			tileset.reset();
+			return nullptr;
 		}
 
-		m_Cache.emplace(filepath, tileset);
+		if (sourceKey.has_value())
+		{
+			StoreCachedTileset(cacheFilepath, *sourceKey, *tileset);
+		}
 
 		return tileset;
 	}
@@ -56,13 +56,38 @@ namespace KAOS { namespace Tiled
 
 
 
+	void TilesetDescriptor::Serialize(BinaryWriter& writer) const
+	{
+		writer.Write(m_Gid);
+		writer.Write(m_Source);
+	}
+
+
+	bool TilesetDescriptor::Deserialize(BinaryReader& reader)
+	{
+		uint64_t gid;
+		std::string source;
+		if (!reader.Read(gid) || !reader.Read(source))
+		{
+			return false;
+		}
+
+		m_Gid = gid;
+		m_Source = move(source);
+
+		return true;
+	}
+
+
+
+
 	size_t TilesetDescriptor::GetGid() const
 	{
 		return m_Gid;
 	}
 
 
-	std::string TilesetDescriptor::GetSource() const
+	const std::string& TilesetDescriptor::GetSource() const
 	{
 		return m_Source;
 	}
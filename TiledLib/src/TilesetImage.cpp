@@ -43,9 +43,33 @@ namespace KAOS { namespace Tiled
 	}
 
 
+	void TilesetImage::Serialize(BinaryWriter& writer) const
+	{
+		writer.Write(m_Source);
+		writer.Write(m_Dimensions.GetWidth());
+		writer.Write(m_Dimensions.GetHeight());
+	}
+
+
+	bool TilesetImage::Deserialize(BinaryReader& reader)
+	{
+		std::string source;
+		Size::value_type width, height;
+		if (!reader.Read(source) || !reader.Read(width) || !reader.Read(height))
+		{
+			return false;
+		}
+
+		m_Source = move(source);
+		m_Dimensions = Size(static_cast<unsigned int>(width), static_cast<unsigned int>(height));
+
+		return true;
+	}
+
+
 
 
-	std::string TilesetImage::GetSource() const
+	const std::string& TilesetImage::GetSource() const
 	{
 		return m_Source;
 	}
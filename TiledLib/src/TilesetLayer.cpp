@@ -5,14 +5,171 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #include <Tiled/TilesetLayer.h>
-#include <KAOS/Common/Utilities.h>
+#include <zlib.h>
+#include <charconv>
+#include <cstring>
+#include <algorithm>
+#include <limits>
 #include <iostream>
 
 
 namespace KAOS { namespace Tiled
 {
 
+	namespace
+	{
+
+		//	Incrementally decodes base64 text into caller supplied buffers so that
+		//	layer data can be fed straight to the inflater or the cell storage.
+		class Base64Reader
+		{
+		public:
+
+			explicit Base64Reader(const char* text)
+				: m_Text(text)
+			{}
+
+			size_t Read(unsigned char* buffer, size_t capacity)
+			{
+				size_t count(0);
+				while (count < capacity)
+				{
+					if (m_BitCount >= 8)
+					{
+						m_BitCount -= 8;
+						buffer[count++] = static_cast<unsigned char>(m_Bits >> m_BitCount);
+						continue;
+					}
+
+					if (m_Finished)
+					{
+						break;
+					}
+
+					const auto ch(*m_Text);
+					if (ch == 0 || ch == '=')
+					{
+						m_Finished = true;
+						continue;
+					}
+
+					++m_Text;
+					if (ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n')
+					{
+						continue;
+					}
+
+					const auto value(DecodeCharacter(ch));
+					if (value < 0)
+					{
+						m_HasError = true;
+						m_Finished = true;
+						break;
+					}
+
+					m_Bits = (m_Bits << 6) | static_cast<unsigned int>(value);
+					m_BitCount += 6;
+				}
+
+				return count;
+			}
+
+			bool HasError() const
+			{
+				return m_HasError;
+			}
+
+
+		private:
+
+			static int DecodeCharacter(char ch)
+			{
+				if (ch >= 'A' && ch <= 'Z') return ch - 'A';
+				if (ch >= 'a' && ch <= 'z') return ch - 'a' + 26;
+				if (ch >= '0' && ch <= '9') return ch - '0' + 52;
+				if (ch == '+') return 62;
+				if (ch == '/') return 63;
+
+				return -1;
+			}
+
+
+		private:
+
+			const char*		m_Text;
+			unsigned int	m_Bits = 0;
+			int				m_BitCount = 0;
+			bool			m_Finished = false;
+			bool			m_HasError = false;
+		};
+
+
+		const char* SkipWhitespace(const char* current, const char* end)
+		{
+			while (current != end && (*current == ' ' || *current == '\t' || *current == '\r' || *current == '\n'))
+			{
+				++current;
+			}
+
+			return current;
+		}
+
+
+		//	Layer data is stored as little endian 32 bit values. Converts the raw
+		//	bytes written into the cell storage to native cell values in place.
+		void ConvertLittleEndianCells(std::vector<unsigned int>& cells)
+		{
+			auto bytes(reinterpret_cast<const unsigned char*>(cells.data()));
+			for (auto& cell : cells)
+			{
+				cell = static_cast<unsigned int>(bytes[0])
+					| (static_cast<unsigned int>(bytes[1]) << 8)
+					| (static_cast<unsigned int>(bytes[2]) << 16)
+					| (static_cast<unsigned int>(bytes[3]) << 24);
+				bytes += sizeof(cell);
+			}
+		}
+
+
+		//	Rounds towards negative infinity so cells left of or above the
+		//	origin map to the correct chunk.
+		int64_t FloorDivide(int64_t value, int64_t divisor)
+		{
+			const auto quotient(value / divisor);
+			return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+		}
+
+
+		template<class CellType_>
+		std::vector<CellType_> NarrowCells(const std::vector<TilesetLayer::cell_type>& cells)
+		{
+			return std::vector<CellType_>(cells.begin(), cells.end());
+		}
+
+	}
+
+
 	bool TilesetLayer::Parse(const pugi::xml_node& layer)
+	{
+		//	Chunked layers stay sparse until a dense view is requested
+		return ParseStreamed(layer, nullptr) && (m_IsChunked ? EnsureChunksDecoded() : StoreDecoded());
+	}
+
+
+	bool TilesetLayer::ParseDeferred(const pugi::xml_node& layer, source_type source)
+	{
+		if (!ParseStreamed(layer, move(source)))
+		{
+			return false;
+		}
+
+		m_DecodeOnFirstUse = true;
+
+		return true;
+	}
+
+
+	bool TilesetLayer::ParseStreamed(const pugi::xml_node& layer, source_type source)
 	{
 		if (!Layer::Parse(layer))
 		{
@@ -48,30 +205,225 @@ namespace KAOS { namespace Tiled
 				std::cerr << "Layer data is missing child container\n";
 				return false;
 			}
+		}
+		else if (layerDataEncoding == "base64")
+		{
+			const std::string compression(layerData.attribute("compression").as_string());
+			if (!compression.empty() && compression != "zlib" && compression != "gzip")
+			{
+				std::cerr << "Unsupported layer data compression `" << compression << "`\n";
+				return false;
+			}
+		}
+		else
+		{
+			std::cerr << "Unknown encoding `" << layerDataEncoding << "`\n";
+			return false;
+		}
+
+		//	Infinite maps split the layer data into chunks. The dense view of
+		//	the layer covers the bounds of all chunks.
+		const auto isChunked(!layerData.child("chunk").empty());
+		int64_t originX(0);
+		int64_t originY(0);
+		if (isChunked)
+		{
+			auto minX(std::numeric_limits<int64_t>::max());
+			auto minY(std::numeric_limits<int64_t>::max());
+			auto maxX(std::numeric_limits<int64_t>::min());
+			auto maxY(std::numeric_limits<int64_t>::min());
+			for (const auto& chunk : layerData.children("chunk"))
+			{
+				const int64_t x(chunk.attribute("x").as_int());
+				const int64_t y(chunk.attribute("y").as_int());
+				const int64_t width(chunk.attribute("width").as_uint());
+				const int64_t height(chunk.attribute("height").as_uint());
+				if (!width || !height)
+				{
+					std::cerr << "Layer data chunk is missing its dimensions\n";
+					return false;
+				}
+
+				minX = std::min(minX, x);
+				minY = std::min(minY, y);
+				maxX = std::max(maxX, x + width);
+				maxY = std::max(maxY, y + height);
+			}
 
-			return ParseCSV(dimensions, layerData.first_child().value());
+			originX = minX;
+			originY = minY;
+			dimensions = Size(static_cast<unsigned int>(maxX - minX), static_cast<unsigned int>(maxY - minY));
 		}
 
-		std::cerr << "Unknown encoding `" << layerDataEncoding << "`\n";
+		m_Dimensions = dimensions;
+		m_OriginX = static_cast<int>(originX);
+		m_OriginY = static_cast<int>(originY);
+		m_DataNode = layerData;
+		m_Source = move(source);
+		m_Data = container_type();
+		m_IsDecoded = false;
+		m_DecodeOnFirstUse = false;
+		m_IsChunked = isChunked;
+		m_Chunks.clear();
+		m_AreChunksDecoded = false;
 
-		return false;
+		return true;
 	}
 
 
 
 
-	bool TilesetLayer::ParseCSV(Size dimensions, const std::string& data)
+	void TilesetLayer::Serialize(BinaryWriter& writer) const
 	{
-		auto values(Common::ConvertToInteger(Common::SplitString(data, ",")));
+		Layer::Serialize(writer);
+		writer.Write(m_Dimensions.GetWidth());
+		writer.Write(m_Dimensions.GetHeight());
+		writer.Write(static_cast<int32_t>(m_OriginX));
+		writer.Write(static_cast<int32_t>(m_OriginY));
+		writer.Write(m_IsChunked);
+
+		//	Layers that have not been decoded yet are decoded into temporaries
+		//	so writing a snapshot does not leave every layer resident.
+		if (m_IsChunked)
+		{
+			chunk_collection_type decodedChunks;
+			if (!m_AreChunksDecoded && !DecodeChunks(decodedChunks))
+			{
+				std::cerr << "Unable to decode data for layer `" << GetName() << "`\n";
+				decodedChunks.clear();
+			}
 
-		if (dimensions.GetCount() != values.size())
+			//	Chunks are written by key so the output does not depend on the
+			//	hash order of the collection.
+			const auto& chunks(m_AreChunksDecoded ? m_Chunks : decodedChunks);
+			std::vector<uint64_t> keys;
+			keys.reserve(chunks.size());
+			for (const auto& chunk : chunks)
+			{
+				keys.push_back(chunk.first);
+			}
+
+			std::sort(keys.begin(), keys.end());
+
+			writer.Write(static_cast<uint64_t>(keys.size()));
+			for (const auto key : keys)
+			{
+				writer.Write(key);
+				writer.WriteBytes(chunks.at(key).data(), sizeof(chunk_type));
+			}
+
+			return;
+		}
+
+		storage_type decodedData(container_type{});
+		if (!m_IsDecoded && !Decode(decodedData))
+		{
+			std::cerr << "Unable to decode data for layer `" << GetName() << "`\n";
+			decodedData = container_type();
+		}
+
+		const auto& data(m_IsDecoded ? m_Data : decodedData);
+		writer.Write(static_cast<uint8_t>(data.index()));
+		std::visit([&writer](const auto& cells)
+		{
+			writer.Write(cells);
+		},
+		data);
+	}
+
+
+	bool TilesetLayer::Deserialize(BinaryReader& reader)
+	{
+		Size::value_type width, height;
+		int32_t originX, originY;
+		bool isChunked;
+		if (   !Layer::Deserialize(reader)
+			|| !reader.Read(width)
+			|| !reader.Read(height)
+			|| !reader.Read(originX)
+			|| !reader.Read(originY)
+			|| !reader.Read(isChunked))
 		{
-			std::cerr << "Size mismatch. Width * Height does not match size of data\n";
 			return false;
 		}
 
+		const Size dimensions(static_cast<unsigned int>(width), static_cast<unsigned int>(height));
+		storage_type data;
+		chunk_collection_type chunks;
+		if (isChunked)
+		{
+			uint64_t chunkCount;
+			if (!reader.Read(chunkCount))
+			{
+				return false;
+			}
+
+			for (auto i(0ULL); i < chunkCount; ++i)
+			{
+				uint64_t key;
+				chunk_type chunk;
+				if (!reader.Read(key) || !reader.ReadBytes(chunk.data(), sizeof(chunk)))
+				{
+					return false;
+				}
+
+				chunks.emplace(key, chunk);
+			}
+		}
+		else
+		{
+			const auto readCells([&reader, &data](auto cells) -> bool
+			{
+				if (!reader.Read(cells))
+				{
+					return false;
+				}
+
+				data = std::move(cells);
+
+				return true;
+			});
+
+			uint8_t cellStorage;
+			if (!reader.Read(cellStorage))
+			{
+				return false;
+			}
+
+			bool isValid(false);
+			switch (static_cast<CellStorage>(cellStorage))
+			{
+			case CellStorage::UInt8:
+				isValid = readCells(std::vector<uint8_t>());
+				break;
+
+			case CellStorage::UInt16:
+				isValid = readCells(std::vector<uint16_t>());
+				break;
+
+			case CellStorage::UInt32:
+				isValid = readCells(container_type());
+				break;
+			}
+
+			const auto cellCount(std::visit([](const auto& cells) { return cells.size(); }, data));
+			if (!isValid || cellCount != dimensions.GetCount())
+			{
+				return false;
+			}
+		}
+
 		m_Dimensions = dimensions;
-		m_Data = move(values);
+		m_OriginX = originX;
+		m_OriginY = originY;
+		m_DataNode = pugi::xml_node();
+		m_Source.reset();
+		m_Data = move(data);
+		m_IsDecoded = !isChunked;
+		m_DecodeOnFirstUse = false;
+		m_IsChunked = isChunked;
+		m_Chunks = move(chunks);
+		m_AreChunksDecoded = isChunked;
 
 		return true;
 	}
@@ -79,27 +431,538 @@ namespace KAOS { namespace Tiled
 
 
 
+	uint64_t TilesetLayer::MakeChunkKey(int chunkX, int chunkY)
+	{
+		return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkY);
+	}
+
+
+	bool TilesetLayer::DecodeRows(const row_visitor_type& visitor) const
+	{
+		if (m_IsChunked)
+		{
+			return DecodeChunkedRows(visitor);
+		}
+
+		const std::string encoding(m_DataNode.attribute("encoding").as_string());
+		if (encoding == "csv")
+		{
+			return DecodeCSV(m_DataNode.first_child().value(), m_Dimensions, visitor);
+		}
+
+		const std::string compression(m_DataNode.attribute("compression").as_string());
+		return DecodeBase64(m_DataNode.child_value(), compression, m_Dimensions, visitor);
+	}
+
+
+	bool TilesetLayer::DecodeChunkedRows(const row_visitor_type& visitor) const
+	{
+		if (!EnsureChunksDecoded())
+		{
+			return false;
+		}
+
+		const int64_t width(m_Dimensions.GetWidth());
+		const int64_t height(m_Dimensions.GetHeight());
+		const auto firstChunkX(FloorDivide(m_OriginX, ChunkSize));
+
+		container_type row(static_cast<size_t>(width));
+		for (auto y(static_cast<int64_t>(m_OriginY)); y < m_OriginY + height; ++y)
+		{
+			std::fill(row.begin(), row.end(), 0);
+
+			const auto chunkY(FloorDivide(y, ChunkSize));
+			const auto chunkRowOffset((y - chunkY * ChunkSize) * ChunkSize);
+			for (auto chunkX(firstChunkX); chunkX * ChunkSize < m_OriginX + width; ++chunkX)
+			{
+				const auto chunk(m_Chunks.find(MakeChunkKey(static_cast<int>(chunkX), static_cast<int>(chunkY))));
+				if (chunk == m_Chunks.end())
+				{
+					continue;
+				}
+
+				const auto left(std::max(chunkX * ChunkSize, static_cast<int64_t>(m_OriginX)));
+				const auto right(std::min((chunkX + 1) * ChunkSize, m_OriginX + width));
+				for (auto x(left); x < right; ++x)
+				{
+					row[static_cast<size_t>(x - m_OriginX)] = chunk->second[chunkRowOffset + x - chunkX * ChunkSize];
+				}
+			}
+
+			if (!visitor(row.data(), row.data() + width))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+
+	bool TilesetLayer::DecodeChunks(chunk_collection_type& chunks) const
+	{
+		const std::string encoding(m_DataNode.attribute("encoding").as_string());
+		const std::string compression(m_DataNode.attribute("compression").as_string());
+
+		for (const auto& chunkNode : m_DataNode.children("chunk"))
+		{
+			const int64_t chunkX(chunkNode.attribute("x").as_int());
+			const Size chunkDimensions(chunkNode.attribute("width").as_uint(), chunkNode.attribute("height").as_uint());
+
+			//	Only cells holding a tile are copied so empty chunks are never created
+			auto y(static_cast<int64_t>(chunkNode.attribute("y").as_int()));
+			const auto storeRow([&chunks, &y, chunkX](const cell_type* begin, const cell_type* end) -> bool
+			{
+				const auto storageY(FloorDivide(y, ChunkSize));
+				const auto storageRowOffset((y - storageY * ChunkSize) * ChunkSize);
+
+				auto x(chunkX);
+				for (auto cell(begin); cell != end; ++cell, ++x)
+				{
+					if (*cell)
+					{
+						const auto storageX(FloorDivide(x, ChunkSize));
+						auto& storage(chunks[MakeChunkKey(static_cast<int>(storageX), static_cast<int>(storageY))]);
+						storage[storageRowOffset + x - storageX * ChunkSize] = *cell;
+					}
+				}
+
+				++y;
+
+				return true;
+			});
+
+			const auto decoded(encoding == "csv"
+				? DecodeCSV(chunkNode.child_value(), chunkDimensions, storeRow)
+				: DecodeBase64(chunkNode.child_value(), compression, chunkDimensions, storeRow));
+			if (!decoded)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+
+	bool TilesetLayer::EnsureChunksDecoded() const
+	{
+		if (m_AreChunksDecoded)
+		{
+			return true;
+		}
+
+		chunk_collection_type chunks;
+		if (!DecodeChunks(chunks))
+		{
+			return false;
+		}
+
+		m_Chunks = move(chunks);
+		m_AreChunksDecoded = true;
+		m_Source.reset();
+
+		return true;
+	}
+
+
+	bool TilesetLayer::DecodeCSV(const char* data, const Size& dimensions, const row_visitor_type& visitor) const
+	{
+		const auto width(dimensions.GetWidth());
+		const auto count(dimensions.GetCount());
+
+		container_type row(width);
+		size_type column(0);
+		size_type total(0);
+
+		const auto end(data + std::strlen(data));
+		auto current(SkipWhitespace(data, end));
+		while (current != end)
+		{
+			if (total == count)
+			{
+				std::cerr << "Size mismatch. Width * Height does not match size of data\n";
+				return false;
+			}
+
+			const auto result(std::from_chars(current, end, row[column]));
+			if (result.ec != std::errc())
+			{
+				std::cerr << "Invalid cell value in layer data\n";
+				return false;
+			}
+
+			++total;
+			if (++column == width)
+			{
+				if (!visitor(row.data(), row.data() + width))
+				{
+					return false;
+				}
+
+				column = 0;
+			}
+
+			current = SkipWhitespace(result.ptr, end);
+			if (current == end)
+			{
+				break;
+			}
+
+			if (*current != ',')
+			{
+				std::cerr << "Unexpected character `" << *current << "` in layer data\n";
+				return false;
+			}
+
+			current = SkipWhitespace(current + 1, end);
+		}
+
+		if (total != count)
+		{
+			std::cerr << "Size mismatch. Width * Height does not match size of data\n";
+			return false;
+		}
+
+		return true;
+	}
+
+
+	bool TilesetLayer::DecodeBase64(
+		const char* data,
+		const std::string& compression,
+		const Size& dimensions,
+		const row_visitor_type& visitor) const
+	{
+		const auto width(dimensions.GetWidth());
+		const auto height(dimensions.GetHeight());
+		const auto rowSize(width * sizeof(cell_type));
+		const auto expectedSize(rowSize * height);
+
+		container_type row(width);
+		auto rowBytes(reinterpret_cast<unsigned char*>(row.data()));
+
+		Base64Reader reader(data);
+		if (compression.empty())
+		{
+			for (auto y(0ULL); y < height; ++y)
+			{
+				if (reader.Read(rowBytes, rowSize) != rowSize)
+				{
+					std::cerr << "Size mismatch. Width * Height does not match size of data\n";
+					return false;
+				}
+
+				ConvertLittleEndianCells(row);
+				if (!visitor(row.data(), row.data() + width))
+				{
+					return false;
+				}
+			}
+
+			unsigned char overflow;
+			if (reader.Read(&overflow, 1) != 0)
+			{
+				std::cerr << "Size mismatch. Width * Height does not match size of data\n";
+				return false;
+			}
+		}
+		else
+		{
+			z_stream stream = {};
+			const auto windowBits(compression == "gzip" ? MAX_WBITS + 16 : MAX_WBITS);
+			if (inflateInit2(&stream, windowBits) != Z_OK)
+			{
+				std::cerr << "Unable to initialize decompression of layer data\n";
+				return false;
+			}
+
+			unsigned char input[4096];
+			unsigned char overflow;
+			stream.next_out = rowBytes;
+			stream.avail_out = static_cast<uInt>(rowSize);
+
+			//	Once the input is exhausted inflate may still hold output it
+			//	could not fit into the last row, so it is called with Z_FINISH
+			//	until the stream ends. Z_FINISH reports Z_BUF_ERROR whenever the
+			//	output fills up; only a call that produces nothing is truncation.
+			auto isInputExhausted(false);
+			const auto inflateNext([&]() -> int
+			{
+				if (stream.avail_in == 0 && !isInputExhausted)
+				{
+					stream.next_in = input;
+					stream.avail_in = static_cast<uInt>(reader.Read(input, sizeof(input)));
+					isInputExhausted = stream.avail_in == 0;
+				}
+
+				const auto previousOut(stream.total_out);
+				const auto result(inflate(&stream, isInputExhausted ? Z_FINISH : Z_NO_FLUSH));
+				return result == Z_BUF_ERROR && stream.total_out != previousOut ? Z_OK : result;
+			});
+
+			auto rows(0ULL);
+			auto status(Z_OK);
+			while (status == Z_OK && rows < height)
+			{
+				status = inflateNext();
+				if ((status == Z_OK || status == Z_STREAM_END) && stream.avail_out == 0)
+				{
+					ConvertLittleEndianCells(row);
+					if (!visitor(row.data(), row.data() + width))
+					{
+						inflateEnd(&stream);
+						return false;
+					}
+
+					stream.next_out = rowBytes;
+					stream.avail_out = static_cast<uInt>(rowSize);
+					++rows;
+				}
+			}
+
+			//	Any data past the last row is a size mismatch.
+			if (status == Z_OK && rows == height)
+			{
+				stream.next_out = &overflow;
+				stream.avail_out = 1;
+				while (status == Z_OK && stream.avail_out)
+				{
+					status = inflateNext();
+				}
+			}
+
+			const auto decompressedSize(stream.total_out);
+			inflateEnd(&stream);
+
+			if (decompressedSize != expectedSize)
+			{
+				std::cerr << "Size mismatch. Width * Height does not match size of data\n";
+				return false;
+			}
+
+			if (status != Z_STREAM_END)
+			{
+				std::cerr << "Unable to decompress " << compression << " layer data\n";
+				return false;
+			}
+		}
+
+		if (reader.HasError())
+		{
+			std::cerr << "Layer data contains invalid base64 characters\n";
+			return false;
+		}
+
+		return true;
+	}
+
+
+	bool TilesetLayer::Decode(storage_type& data) const
+	{
+		container_type cells;
+		cells.reserve(m_Dimensions.GetCount());
+
+		const auto appendRow([&cells](const cell_type* begin, const cell_type* end) -> bool
+		{
+			cells.insert(cells.end(), begin, end);
+			return true;
+		});
+
+		if (!DecodeRows(appendRow))
+		{
+			return false;
+		}
+
+		//	Narrow the storage to the smallest cell type that holds every GID
+		const auto maxGid(cells.empty() ? 0 : *std::max_element(cells.begin(), cells.end()));
+		if (maxGid <= std::numeric_limits<uint8_t>::max())
+		{
+			data = NarrowCells<uint8_t>(cells);
+		}
+		else if (maxGid <= std::numeric_limits<uint16_t>::max())
+		{
+			data = NarrowCells<uint16_t>(cells);
+		}
+		else
+		{
+			data = move(cells);
+		}
+
+		return true;
+	}
+
+
+	bool TilesetLayer::StoreDecoded() const
+	{
+		storage_type data;
+		if (!Decode(data))
+		{
+			return false;
+		}
+
+		m_Data = move(data);
+		m_IsDecoded = true;
+		m_Source.reset();
+
+		return true;
+	}
+
+
+	void TilesetLayer::EnsureDecoded() const
+	{
+		if (!m_IsDecoded && !StoreDecoded())
+		{
+			std::cerr << "Unable to decode data for layer `" << GetName() << "`\n";
+			m_IsDecoded = true;
+			m_Source.reset();
+		}
+	}
+
+
+
+
 	Size TilesetLayer::GetDimensions() const
 	{
 		return m_Dimensions;
 	}
 
 
+	int TilesetLayer::GetOriginX() const
+	{
+		return m_OriginX;
+	}
+
+
+	int TilesetLayer::GetOriginY() const
+	{
+		return m_OriginY;
+	}
+
+
+	bool TilesetLayer::IsChunked() const
+	{
+		return m_IsChunked;
+	}
+
+
+	const TilesetLayer::chunk_type* TilesetLayer::FindChunk(int chunkX, int chunkY) const
+	{
+		if (!m_IsChunked || !EnsureChunksDecoded())
+		{
+			return nullptr;
+		}
+
+		const auto chunk(m_Chunks.find(MakeChunkKey(chunkX, chunkY)));
+		return chunk != m_Chunks.end() ? &chunk->second : nullptr;
+	}
+
+
+	TilesetLayer::cell_type TilesetLayer::GetCell(int x, int y) const
+	{
+		if (m_IsChunked)
+		{
+			const auto chunkX(FloorDivide(x, ChunkSize));
+			const auto chunkY(FloorDivide(y, ChunkSize));
+			const auto chunk(FindChunk(static_cast<int>(chunkX), static_cast<int>(chunkY)));
+
+			return chunk ? (*chunk)[(y - chunkY * ChunkSize) * ChunkSize + x - chunkX * ChunkSize] : 0;
+		}
+
+		const auto column(static_cast<int64_t>(x) - m_OriginX);
+		const auto row(static_cast<int64_t>(y) - m_OriginY);
+		if (column < 0 || row < 0 || uint64_t(column) >= m_Dimensions.GetWidth() || uint64_t(row) >= m_Dimensions.GetHeight())
+		{
+			return 0;
+		}
+
+		const auto index(static_cast<size_t>(row * m_Dimensions.GetWidth() + column));
+		EnsureDecoded();
+		return std::visit([index](const auto& cells) -> cell_type
+		{
+			return index < cells.size() ? cells[index] : 0;
+		},
+		m_Data);
+	}
+
+
+	bool TilesetLayer::VisitRows(const row_visitor_type& visitor) const
+	{
+		//	Chunked layers are visited straight from the sparse chunks
+		if (!m_IsDecoded && (!m_DecodeOnFirstUse || m_IsChunked))
+		{
+			return DecodeRows(visitor);
+		}
+
+		EnsureDecoded();
+
+		const auto width(m_Dimensions.GetWidth());
+		if (size() != m_Dimensions.GetCount())
+		{
+			return false;
+		}
+
+		//	Narrow rows are widened into a scratch row before being visited
+		container_type wideRow(width);
+		return VisitCells([width, &wideRow, &visitor](const auto& cells) -> bool
+		{
+			for (auto row(cells.begin()); width && row != cells.end(); row += width)
+			{
+				if constexpr (std::is_same_v<std::decay_t<decltype(*row)>, cell_type>)
+				{
+					if (!visitor(row, row + width))
+					{
+						return false;
+					}
+				}
+				else
+				{
+					std::copy(row, row + width, wideRow.begin());
+					if (!visitor(wideRow.data(), wideRow.data() + width))
+					{
+						return false;
+					}
+				}
+			}
+
+			return true;
+		});
+	}
+
+
+	TilesetLayer::CellStorage TilesetLayer::GetCellStorage() const
+	{
+		EnsureDecoded();
+		return static_cast<CellStorage>(m_Data.index());
+	}
+
+
 	TilesetLayer::size_type TilesetLayer::size() const
 	{
-		return m_Data.size();
+		EnsureDecoded();
+		return std::visit([](const auto& cells) { return cells.size(); }, m_Data);
 	}
 
 
 	TilesetLayer::const_iterator TilesetLayer::begin() const
 	{
-		return m_Data.cbegin();
+		EnsureDecoded();
+		return std::visit([](const auto& cells)
+		{
+			return const_iterator(reinterpret_cast<const unsigned char*>(cells.data()), sizeof(cells[0]));
+		},
+		m_Data);
 	}
 
 
 	TilesetLayer::const_iterator TilesetLayer::end() const
 	{
-		return m_Data.cend();
+		EnsureDecoded();
+		return std::visit([](const auto& cells)
+		{
+			return const_iterator(reinterpret_cast<const unsigned char*>(cells.data() + cells.size()), sizeof(cells[0]));
+		},
+		m_Data);
 	}
 
 }}
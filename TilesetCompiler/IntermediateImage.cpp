@@ -9,21 +9,19 @@
 
 namespace
 {
-	IntermediateImage::row_list_type GenerateRows(const KAOS::Imaging::Image& image)
+	IntermediateImage::row_list_type GenerateRows(const KAOS::Imaging::ImageView& image)
 	{
 		if (image.GetWidth() & 1)
 		{
 			throw std::invalid_argument("Images must be an even number of pixels wide.");
 		}
 
-		const auto& rows(image.GetRows());
-
 		std::vector<IntermediateImageRow> intermediateRows;
-		for (auto i(0u); i < rows.size(); ++i)
+		for (auto i(0u); i < image.GetHeight(); ++i)
 		{
-			const auto& currentRow(rows[i]);
+			const auto rowEnd(image.GetRow(i) + image.GetWidth());
 			IntermediateImageRow::row_data_type rowData;
-			for (auto pixel(currentRow.begin()); pixel != currentRow.end(); )
+			for (auto pixel(image.GetRow(i)); pixel != rowEnd; )
 			{
 				const auto high(*pixel++);
 				const auto low(*pixel++);
@@ -44,7 +42,7 @@ namespace
 }
 
 
-IntermediateImage::IntermediateImage(const KAOS::Imaging::Image& image)
+IntermediateImage::IntermediateImage(const KAOS::Imaging::ImageView& image)
 	: m_Rows(GenerateRows(image))
 {}
 
@@ -24,7 +24,7 @@ public:
 
 public:
 
-	IntermediateImage(const KAOS::Imaging::Image& image);
+	IntermediateImage(const KAOS::Imaging::ImageView& image);
 
 	row_list_type::value_type& operator[](size_type index);
 	const row_list_type::value_type& operator[](size_type index) const;
@@ -8,7 +8,7 @@
 
 
 
-Tile::Tile(std::shared_ptr<KAOS::Imaging::Image> image, size_t textureId)
+Tile::Tile(KAOS::Imaging::ImageView image, size_t textureId)
 	:
 	m_Image(image),
 	m_TextureId(textureId)
@@ -39,10 +39,10 @@ bool Tile::HasIdAlias() const
 void Tile::SetAliasId(size_t newId)
 {
 	m_AliasTextureId = newId;
-	m_Image = nullptr;
+	m_Image.reset();
 }
 
-std::shared_ptr<const KAOS::Imaging::Image> Tile::GetImage() const
+const std::optional<KAOS::Imaging::ImageView>& Tile::GetImage() const
 {
 	return m_Image;
 }
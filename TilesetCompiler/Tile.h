@@ -5,15 +5,15 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #pragma once
-#include <KAOS/Imaging/Image.h>
-#include <memory>
+#include <KAOS/Imaging/ImageView.h>
+#include <optional>
 
 
 class Tile
 {
 public:
 
-	Tile(std::shared_ptr<KAOS::Imaging::Image> image, size_t textureId);
+	Tile(KAOS::Imaging::ImageView image, size_t textureId);
 	Tile(size_t textureId);
 
 	size_t GetId() const;
@@ -22,14 +22,14 @@ public:
 	bool HasIdAlias() const;
 	void SetAliasId(size_t newId);
 
-	std::shared_ptr<const KAOS::Imaging::Image> GetImage() const;
+	const std::optional<KAOS::Imaging::ImageView>& GetImage() const;
 
 
 private:
 
 	size_t									m_TextureId;
 	std::optional<size_t>					m_AliasTextureId;
-	std::shared_ptr<KAOS::Imaging::Image>	m_Image;
+	std::optional<KAOS::Imaging::ImageView>	m_Image;
 };
 
 
@@ -0,0 +1,91 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#pragma once
+#include <new>
+#include <cstddef>
+
+
+namespace KAOS { namespace Common
+{
+
+	//	Standard allocator that hands out storage aligned to Alignment_ bytes
+	//	so that containers can be used directly by vectorized code.
+	template<class Type_, size_t Alignment_>
+	class AlignedAllocator
+	{
+	public:
+
+		static_assert(Alignment_ >= alignof(Type_), "Alignment must satisfy the alignment of the allocated type");
+		static_assert((Alignment_ & (Alignment_ - 1)) == 0, "Alignment must be a power of two");
+
+		using value_type = Type_;
+
+		template<class OtherType_>
+		struct rebind
+		{
+			using other = AlignedAllocator<OtherType_, Alignment_>;
+		};
+
+
+	public:
+
+		AlignedAllocator() noexcept = default;
+
+		template<class OtherType_>
+		AlignedAllocator(const AlignedAllocator<OtherType_, Alignment_>&) noexcept
+		{}
+
+		Type_* allocate(size_t count)
+		{
+			return static_cast<Type_*>(::operator new(count * sizeof(Type_), std::align_val_t(Alignment_)));
+		}
+
+		void deallocate(Type_* pointer, size_t /*count*/) noexcept
+		{
+			::operator delete(pointer, std::align_val_t(Alignment_));
+		}
+
+		template<class OtherType_>
+		bool operator==(const AlignedAllocator<OtherType_, Alignment_>&) const noexcept
+		{
+			return true;
+		}
+
+		template<class OtherType_>
+		bool operator!=(const AlignedAllocator<OtherType_, Alignment_>&) const noexcept
+		{
+			return false;
+		}
+	};
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
@@ -10,11 +10,20 @@
 #include <optional>
 #include <sstream>
 #include <iomanip>
+#include <cstdint>
 
 
 namespace KAOS { namespace Common
 {
 
+	//	Identifies a file independent of the path used to reach it
+	struct FileIdentity
+	{
+		uint64_t	device = 0;
+		uint64_t	inode = 0;
+	};
+
+
 	std::vector<std::string> SplitString(const std::string& text, const std::string& delim);
 	std::vector<unsigned int> ConvertToInteger(const std::vector<std::string>& values);
 	std::string TrimString(std::string str);
@@ -25,6 +34,12 @@ namespace KAOS { namespace Common
 	std::string GetFileExtension(std::string path);
 	bool IsAbsolutePath(const std::string& path);
 	std::string EnsureAbsolutePath(const std::string& relativePath);
+	//	Resolves `.`, `..` and symbolic links. Results are memoized for the
+	//	lifetime of the process so changes to links made after the first
+	//	call for a path are not picked up.
+	std::string CanonicalizePath(const std::string& path);
+	//	Only available on platforms that expose device and inode numbers
+	std::optional<FileIdentity> QueryFileIdentity(const std::string& path);
 	std::string GetDirectoryFromFilePath(std::string path);
 	std::string GetAbsolutePathFromFilePath(const std::string& filePath);
 	std::optional<std::string> GetRelativePathFromFilePath(
@@ -5,6 +5,7 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #pragma once
+#include <KAOS/Common/MappedFile.h>
 #include <pugixml/pugixml.hpp>
 #include <string>
 #include <optional>
@@ -17,6 +18,33 @@ namespace KAOS { namespace Common { namespace XML
 	bool LoadAttribute(const pugi::xml_node& node, const std::string& name, uint64_t& output);
 	bool LoadAttribute(const pugi::xml_node& node, const std::string& name, std::optional<uint64_t>& output);
 
+
+	//	XML document parsed in place from a memory mapped file. Node names and
+	//	values point directly into the mapping so it is kept alive alongside the
+	//	document.
+	class MappedDocument
+	{
+	public:
+
+		static const unsigned int DefaultParseOptions = pugi::parse_default;
+
+	public:
+
+		MappedDocument() = default;
+		MappedDocument(const MappedDocument&) = delete;
+		MappedDocument& operator=(const MappedDocument&) = delete;
+
+		bool Load(const std::string& filepath, unsigned int options = DefaultParseOptions);
+
+		const pugi::xml_document& GetDocument() const;
+
+
+	private:
+
+		MappedFile			m_File;
+		pugi::xml_document	m_Document;
+	};
+
 }}}
 
 
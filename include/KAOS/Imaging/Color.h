@@ -6,6 +6,7 @@
 //	of this file.
 #pragma once
 #include <string>
+#include <cstdint>
 
 
 namespace KAOS { namespace Imaging
@@ -19,7 +20,34 @@ namespace KAOS { namespace Imaging
 		Color(uint8_t red = 0, uint8_t green = 0, uint8_t blue = 0, uint8_t alpha = 255);
 
 
-		bool operator==(const Color& other) const;
+		bool operator==(const Color& other) const
+		{
+			return toPacked() == other.toPacked();
+		}
+
+		bool operator!=(const Color& other) const
+		{
+			return toPacked() != other.toPacked();
+		}
+
+		//	Returns the color as a single 32 bit RGBA value so colors can be
+		//	compared and hashed with one integer operation.
+		uint32_t toPacked() const
+		{
+			return uint32_t(red)
+				| (uint32_t(green) << 8)
+				| (uint32_t(blue) << 16)
+				| (uint32_t(alpha) << 24);
+		}
+
+		static Color fromPacked(uint32_t value)
+		{
+			return Color(
+				uint8_t(value),
+				uint8_t(value >> 8),
+				uint8_t(value >> 16),
+				uint8_t(value >> 24));
+		}
 
 		bool isFullOpaque() const
 		{
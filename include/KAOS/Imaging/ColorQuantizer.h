@@ -0,0 +1,109 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#pragma once
+#include <KAOS/Imaging/Color.h>
+#include <KAOS/Imaging/Palette.h>
+#include <KAOS/Imaging/Image.h>
+#include <KAOS/Imaging/ImageView.h>
+#include <optional>
+#include <vector>
+#include <cstdint>
+
+
+namespace KAOS { namespace Imaging
+{
+
+	//	Maps arbitrary colors to the nearest entry of a fixed palette through a
+	//	precomputed 3D lookup table so converting a pixel costs a single table
+	//	load. Optional ordered dithering spreads the quantization error of
+	//	smooth gradients across neighboring pixels.
+	class ColorQuantizer
+	{
+	public:
+
+		//	Bits per channel used to index the lookup table
+		static const size_t TableBits = 5;
+
+		enum class Dithering
+		{
+			None,
+			Ordered
+		};
+
+
+	public:
+
+		//	Derives the dither spread from the palette as the average distance
+		//	between each color and its nearest neighbor.
+		explicit ColorQuantizer(Palette palette);
+		//	ditherSpread is the channel distance covered by the dither pattern
+		//	and should roughly match the spacing between palette levels.
+		ColorQuantizer(Palette palette, unsigned int ditherSpread);
+
+		//	Creates a quantizer targeting the 64 color RGB palette of the CoCo 3.
+		//	Palette indices are the hardware RRGGBB values and each channel is
+		//	split at the same thresholds as ConvertColorToRGBRGB.
+		static ColorQuantizer CreateForCoCo3RGB();
+
+		const Palette& GetPalette() const;
+
+		uint8_t Quantize(const Color& color) const;
+
+		//	Pixels with an alpha other than 255 are mapped to transparentIndex
+		//	when one is provided and quantized like any other color otherwise.
+		Image Quantize(
+			const ColorImageView& image,
+			Dithering dithering = Dithering::None,
+			std::optional<uint8_t> transparentIndex = std::nullopt) const;
+
+
+	private:
+
+		size_t GetTableIndex(uint8_t red, uint8_t green, uint8_t blue) const
+		{
+			return (size_t(m_ChannelCells[red]) << (TableBits * 2))
+				| (size_t(m_ChannelCells[green]) << TableBits)
+				| m_ChannelCells[blue];
+		}
+
+
+	private:
+
+		Palette					m_Palette;
+		std::vector<uint8_t>	m_Table;
+		//	Table cell of each channel value. Defaults to the top TableBits bits.
+		uint8_t					m_ChannelCells[256];
+		int						m_DitherOffsets[16];
+	};
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
@@ -0,0 +1,92 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#pragma once
+#include <KAOS/Imaging/Color.h>
+#include <KAOS/Imaging/Palette.h>
+#include <optional>
+#include <vector>
+#include <cstdint>
+
+
+namespace KAOS { namespace Imaging
+{
+
+	//	Converts runs of decoded RGBA pixels to 8 bit palette indices. Palettes
+	//	of up to MaxVectorColors colors are matched with SSE2 or AVX2 when the
+	//	processor supports them; larger palettes use the palette's hashed
+	//	lookup. The palette must outlive the converter and Rebuild() must be
+	//	called after colors are added to it.
+	class IndexedPixelConverter
+	{
+	public:
+
+		static const size_t MaxVectorColors = 16;
+
+
+	public:
+
+		//	Pixels with an alpha other than 255 are mapped to transparentIndex
+		//	when one is provided and looked up in the palette otherwise.
+		IndexedPixelConverter(const Palette& palette, std::optional<uint8_t> transparentIndex);
+
+		void Rebuild();
+
+		//	Converts up to count pixels and returns the number converted.
+		//	Conversion stops at the first pixel whose color is not in the
+		//	palette or whose index does not fit in 8 bits.
+		size_t Convert(const uint8_t* rgba, uint8_t* output, size_t count) const;
+
+
+	private:
+
+		const Palette*			m_Palette;
+		std::optional<uint8_t>	m_TransparentIndex;
+		std::vector<uint32_t>	m_VectorColors;
+	};
+
+
+	//	Copies decoded RGBA pixels into a row of colors.
+	void ConvertRGBAToColors(const uint8_t* rgba, Color* output, size_t count);
+
+	//	Packs pairs of 4 bit palette indices into bytes, left pixel in the high
+	//	nibble, and builds the matching transparency mask. Indices equal to
+	//	transparentIndex produce a zero pixel and a set mask nibble. The data
+	//	and mask buffers must hold count / 2 bytes.
+	void PackIndexedNibbles(
+		const uint8_t* indices,
+		size_t count,
+		uint8_t transparentIndex,
+		uint8_t* data,
+		uint8_t* mask);
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
@@ -0,0 +1,120 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#pragma once
+#include "Map.h"
+#include "TilesetCache.h"
+#include <vector>
+#include <cstdint>
+
+
+namespace KAOS { namespace Tiled
+{
+
+	//	Maps the global tile ids (GIDs) stored in layer cells to the tileset
+	//	that owns them. A flat table indexed by GID is built once per map so
+	//	each cell resolves with a single indexed load.
+	class GidResolver
+	{
+	public:
+
+		using gid_type = TilesetLayer::cell_type;
+		using tileset_index_type = uint32_t;
+		using id_type = uint32_t;
+
+		//	Flip and rotation flags stored in the upper four bits of a GID
+		enum FlipFlags : uint8_t
+		{
+			None = 0,
+			RotatedHexagonal120 = 1 << 0,
+			FlippedDiagonally = 1 << 1,
+			FlippedVertically = 1 << 2,
+			FlippedHorizontally = 1 << 3
+		};
+
+		static const tileset_index_type NoTileset = ~tileset_index_type(0);
+
+		struct ResolvedCell
+		{
+			tileset_index_type	tilesetIndex = NoTileset;	//	Index into Map::GetTilesets()
+			id_type				localId = 0;				//	Tile id within the tileset
+			uint8_t				flags = FlipFlags::None;
+
+			bool IsEmpty() const
+			{
+				return tilesetIndex == NoTileset;
+			}
+		};
+
+
+	public:
+
+		bool Build(const Map& map, TilesetCache& tilesetCache);
+		bool Build(const Map::tileset_container_type& tilesets, const std::vector<size_t>& tileCounts);
+
+		size_t GetTilesetCount() const;
+		size_t GetTileCount(tileset_index_type tilesetIndex) const;
+
+		//	Empty cells (GID 0) and GIDs that do not belong to any tileset
+		//	resolve to an empty cell.
+		ResolvedCell Resolve(gid_type gid) const
+		{
+			const auto id(gid & IdMask);
+			const auto& entry(m_Entries[id < m_Entries.size() ? id : 0]);
+
+			return { entry.tilesetIndex, entry.localId, static_cast<uint8_t>(gid >> FlagShift) };
+		}
+
+		//	Resolves a run of cells, typically a whole layer row. Returns false
+		//	if a non-empty GID does not belong to any tileset.
+		bool Resolve(const gid_type* begin, const gid_type* end, ResolvedCell* resolvedOut) const;
+
+
+	protected:
+
+		static const unsigned int FlagShift = 28;
+		static const gid_type IdMask = (gid_type(1) << FlagShift) - 1;
+
+		struct Entry
+		{
+			tileset_index_type	tilesetIndex;
+			id_type				localId;
+		};
+
+
+	private:
+
+		std::vector<Entry>	m_Entries = { Entry{ NoTileset, 0 } };	//	GID 0 is always empty
+		std::vector<size_t>	m_TileCounts;
+	};
+
+}}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
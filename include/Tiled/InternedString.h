@@ -0,0 +1,143 @@
+//	Tiled Map Converter for KAOS on the Color Computer III
+//	------------------------------------------------------
+//	Copyright (C) 2018, by Chet Simpson
+//	
+//	This file is distributed under the MIT License. See notice at the end
+//	of this file.
+#pragma once
+#include <string>
+#include <optional>
+#include <functional>
+#include <cstdint>
+
+
+namespace KAOS { namespace Tiled
+{
+
+	//	Handle to a string stored once in a process-wide pool. Equal strings
+	//	always share the same storage so comparing and hashing handles only
+	//	touches the pointer. Pooled strings are never released; the pool is
+	//	meant for names, types and property keys which repeat heavily across
+	//	maps and tilesets. Interning is thread safe.
+	class InternedString
+	{
+	public:
+
+		using id_type = uintptr_t;
+
+
+	public:
+
+		InternedString()
+			: m_Text(&m_EmptyString)
+		{}
+
+		//	Interning is explicit as pooled strings are never released
+		explicit InternedString(const std::string& text)
+			: m_Text(Intern(text))
+		{}
+
+		explicit InternedString(const char* text)
+			: m_Text(Intern(text))
+		{}
+
+		InternedString(const InternedString&) = default;
+		InternedString& operator=(const InternedString&) = default;
+
+
+		//	Returns the interned string without adding it to the pool if it
+		//	has not been interned yet.
+		static std::optional<InternedString> Find(const std::string& text);
+
+
+		const std::string& str() const
+		{
+			return *m_Text;
+		}
+
+		operator const std::string&() const
+		{
+			return *m_Text;
+		}
+
+		bool empty() const
+		{
+			return m_Text->empty();
+		}
+
+		//	Stable for the lifetime of the process. Ordering by id is not
+		//	lexicographic.
+		id_type GetId() const
+		{
+			return reinterpret_cast<id_type>(m_Text);
+		}
+
+		bool operator==(const InternedString& other) const
+		{
+			return m_Text == other.m_Text;
+		}
+
+		bool operator!=(const InternedString& other) const
+		{
+			return m_Text != other.m_Text;
+		}
+
+
+	private:
+
+		explicit InternedString(const std::string* text)
+			: m_Text(text)
+		{}
+
+		static const std::string* Intern(const std::string& text);
+
+
+	private:
+
+		static const std::string	m_EmptyString;
+
+		const std::string*	m_Text;
+	};
+
+}}
+
+
+namespace std
+{
+
+	template<>
+	struct hash<KAOS::Tiled::InternedString>
+	{
+		size_t operator()(const KAOS::Tiled::InternedString& value) const
+		{
+			return hash<KAOS::Tiled::InternedString::id_type>()(value.GetId());
+		}
+	};
+
+}
+
+
+
+
+//	Copyright (c) 2018 Chet Simpson
+//	
+//	Permission is hereby granted, free of charge, to any person
+//	obtaining a copy of this software and associated documentation
+//	files (the "Software"), to deal in the Software without
+//	restriction, including without limitation the rights to use,
+//	copy, modify, merge, publish, distribute, sublicense, and/or sell
+//	copies of the Software, and to permit persons to whom the
+//	Software is furnished to do so, subject to the following
+//	conditions:
+//	
+//	The above copyright notice and this permission notice shall be
+//	included in all copies or substantial portions of the Software.
+//	
+//	THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+//	EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+//	OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+//	NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+//	HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+//	WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+//	FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+//	OTHER DEALINGS IN THE SOFTWARE.
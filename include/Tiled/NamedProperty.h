@@ -5,6 +5,8 @@
 //	This file is distributed under the MIT License. See notice at the end
 //	of this file.
 #pragma once
+#include "BinaryStream.h"
+#include "InternedString.h"
 #include <KAOS/Common/Property.h>
 #include <pugixml/pugixml.hpp>
 
@@ -17,20 +19,25 @@ namespace KAOS { namespace Tiled
 	public:
 
 		NamedProperty() = default;
-		NamedProperty(std::string name, const bool_type& value);
-		NamedProperty(std::string name, const int_type& value);
-		NamedProperty(std::string name, const float_type& value);
-		NamedProperty(std::string name, const color_type& value);
-		NamedProperty(std::string name, string_type value);
+		NamedProperty(const std::string& name, const bool_type& value);
+		NamedProperty(const std::string& name, const int_type& value);
+		NamedProperty(const std::string& name, const float_type& value);
+		NamedProperty(const std::string& name, const color_type& value);
+		NamedProperty(const std::string& name, string_type value);
+		NamedProperty(const InternedString& name, KAOS::Common::Property value);
 
-		std::string GetName() const;
+		const std::string& GetName() const;
+		const InternedString& GetInternedName() const;
 
 		bool Parse(const pugi::xml_node& node);
 
+		void Serialize(BinaryWriter& writer) const;
+		bool Deserialize(BinaryReader& reader);
+
 
 	private:
 
-		std::string	m_Name;
+		InternedString	m_Name;
 	};
 
 }}
@@ -25,17 +25,18 @@ namespace KAOS { namespace Tiled
 		virtual bool Parse(const pugi::xml_node& objectNode);
 
 
-		std::string GetName() const;
-		std::string GetType() const;
+		const std::string& GetName() const;
+		const std::string& GetType() const;
 		int GetXPos() const;
 		int GetYPos() const;
 
 		virtual std::optional<PropertyBag::value_type> QueryProperty(const std::string& name) const;
+		const PropertyBag::value_type* FindProperty(const std::string& name) const;
 
 	private:
 
-		std::string		m_Name;
-		std::string		m_Type;
+		InternedString	m_Name;
+		InternedString	m_Type;
 		int				m_XPos = 0;
 		int				m_YPos = 0;
 		PropertyBag		m_PropertyBag;
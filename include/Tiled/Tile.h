@@ -30,11 +30,16 @@ namespace KAOS { namespace Tiled
 
 		bool Parse(const pugi::xml_node& node);
 
+		void Serialize(BinaryWriter& writer) const;
+		bool Deserialize(BinaryReader& reader);
+
 		id_type GetId() const;
-		std::string GetType() const;
+		const std::string& GetType() const;
 		float_t GetProbability() const;
-		frame_container GetAnimationFrames() const;
+		const frame_container& GetAnimationFrames() const;
+		const PropertyBag& GetProperties() const;
 		std::optional<PropertyBag::value_type> QueryProperty(const std::string& name) const;
+		const PropertyBag::value_type* FindProperty(const std::string& name) const;
 
 
 	protected:
@@ -52,7 +57,7 @@ namespace KAOS { namespace Tiled
 	private:
 
 		id_type			m_Id;
-		std::string		m_Type;
+		InternedString	m_Type;
 		float_t			m_Probability;
 		frame_container	m_AnimationFrames;
 		ObjectGroup		m_Objects;
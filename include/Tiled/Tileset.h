@@ -6,11 +6,13 @@
 //	of this file.
 #pragma once
 #include "Tile.h"
+#include "TilePropertyColumn.h"
 #include "TilesetImage.h"
 #include "PropertyBag.h"
 #include "Size.h"
 #include <string>
 #include <map>
+#include <unordered_map>
 
 
 namespace KAOS { namespace Tiled
@@ -21,6 +23,7 @@ namespace KAOS { namespace Tiled
 	public:
 
 		using tile_collection_type = std::map<size_t, Tile>;
+		using property_column_collection_type = std::unordered_map<InternedString, TilePropertyColumn>;
 
 
 	public:
@@ -29,22 +32,36 @@ namespace KAOS { namespace Tiled
 
 		bool Parse(const pugi::xml_node& node, std::string filepath);
 
-		std::string GetFilePath() const;
-		std::string GetFilename() const;
-		std::string GetDirectory() const;
-		std::string GetName() const;
+		void Serialize(BinaryWriter& writer) const;
+		bool Deserialize(BinaryReader& reader);
+
+		const std::string& GetFilePath() const;
+		const std::string& GetFilename() const;
+		const std::string& GetDirectory() const;
+		const std::string& GetName() const;
 		Size GetTileDimensions() const;
 		size_t GetTileCount() const;
 		size_t GetColumns() const;
 		size_t GetMargin() const;
 		size_t GetSpacing() const;
-		TilesetImage GetImage() const;
-		tile_collection_type GetTiles() const;
+		const TilesetImage& GetImage() const;
+		const tile_collection_type& GetTiles() const;
 		std::optional<PropertyBag::value_type> QueryProperty(const std::string& name) const;
+		const PropertyBag::value_type* FindProperty(const std::string& name) const;
+		//	Returns the values of a tile property for all tiles or nullptr if
+		//	no tile defines the property.
+		const TilePropertyColumn* FindTilePropertyColumn(const std::string& name) const;
+		const TilePropertyColumn* FindTilePropertyColumn(const InternedString& name) const;
+
+		//	Approximate number of bytes held by the tileset. Property values
+		//	and interned strings are not included.
+		size_t EstimateMemoryUsage() const;
 
 
 	protected:
 
+		void BuildTilePropertyColumns();
+
 		bool ParseChildren(
 			const pugi::xml_node& rootNode,
 			tile_collection_type& tileDefinitionsOut,
@@ -66,6 +83,7 @@ namespace KAOS { namespace Tiled
 		TilesetImage			m_TilesetImage;
 		tile_collection_type	m_TileDefinitions;
 		PropertyBag				m_Properties;
+		property_column_collection_type	m_TilePropertyColumns;
 	};
 
 }}
@@ -8,7 +8,11 @@
 #include "Tileset.h"
 #include <string>
 #include <map>
+#include <list>
 #include <memory>
+#include <mutex>
+#include <future>
+#include <vector>
 
 
 namespace KAOS { namespace Tiled
@@ -19,16 +23,72 @@ namespace KAOS { namespace Tiled
 	public:
 
 		using value_type = std::shared_ptr<const Tileset>;
-		using collection_type = std::map<std::string, value_type>;
+		using future_type = std::shared_future<value_type>;
+
+
+		struct Statistics
+		{
+			size_t	hits = 0;
+			size_t	misses = 0;
+			size_t	evictions = 0;
+			size_t	memoryUsage = 0;	//	Estimated bytes held by cached tilesets
+		};
 
 
 	public:
 
+		TilesetCache() = default;
+		TilesetCache(const TilesetCache&) = delete;
+		//	Parsed tilesets are also stored in `cacheDirectory` and reused by
+		//	later runs as long as the source file is unchanged.
+		explicit TilesetCache(std::string cacheDirectory);
+
+		//	Safe to call from multiple threads. Each tileset is loaded exactly
+		//	once; concurrent requests for the same file wait for that load.
 		std::optional<value_type> Load(const std::string& filepath);
+		//	Loads the tilesets in parallel. Returns false if any of them failed.
+		bool Preload(const std::vector<std::string>& filepaths);
+
+		//	Once the estimated size of the cached tilesets exceeds the budget
+		//	the least recently used ones are evicted. Tilesets still referenced
+		//	outside of the cache are never evicted. A budget of 0 disables
+		//	eviction.
+		void SetMemoryBudget(size_t bytes);
+		size_t GetMemoryBudget() const;
+		Statistics GetStatistics() const;
+
+
+	protected:
+
+		value_type LoadTileset(const std::string& filepath) const;
+		//	Must be called with m_Mutex held
+		void EvictLeastRecentlyUsed();
+
+
+	private:
+
+		//	Most recently used first
+		using usage_list_type = std::list<std::string>;
+
+		struct Entry
+		{
+			future_type					tileset;
+			bool						isLoaded = false;
+			size_t						memoryUsage = 0;
+			usage_list_type::iterator	usagePosition;
+		};
+
+		using collection_type = std::map<std::string, Entry>;
+
 
 	private:
 
-		collection_type	m_Cache;
+		std::string			m_CacheDirectory;
+		mutable std::mutex	m_Mutex;
+		collection_type		m_Cache;
+		usage_list_type		m_UsageOrder;
+		size_t				m_MemoryBudget = 0;
+		Statistics			m_Statistics;
 	};
 
 }}
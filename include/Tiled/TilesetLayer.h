@@ -9,6 +9,13 @@
 #include "Size.h"
 #include <string>
 #include <vector>
+#include <memory>
+#include <functional>
+#include <variant>
+#include <iterator>
+#include <array>
+#include <unordered_map>
+#include <cstdint>
 
 
 namespace KAOS { namespace Tiled
@@ -18,10 +25,132 @@ namespace KAOS { namespace Tiled
 	{
 	public:
 
-		using cell_type = unsigned int;
+		using cell_type = uint32_t;
 		using container_type = std::vector<cell_type>;
 		using size_type = container_type::size_type;
-		using const_iterator = container_type::const_iterator;
+		//	Receives each row of cells as the range [begin, end). Returning
+		//	false stops the traversal.
+		using row_visitor_type = std::function<bool(const cell_type* begin, const cell_type* end)>;
+
+		//	Layers of infinite maps are stored sparsely in fixed size chunks.
+		//	Chunks that do not contain any tiles are not stored.
+		static const int ChunkSize = 16;
+		using chunk_type = std::array<cell_type, ChunkSize * ChunkSize>;
+		using chunk_collection_type = std::unordered_map<uint64_t, chunk_type>;
+
+		//	Decoded cells are stored in the narrowest type that can hold the
+		//	largest GID in the layer.
+		enum class CellStorage
+		{
+			UInt8,
+			UInt16,
+			UInt32
+		};
+
+
+		//	Typed view of the stored cells
+		template<class CellType_>
+		class CellRange
+		{
+		public:
+
+			using value_type = CellType_;
+
+			CellRange(const value_type* begin, const value_type* end)
+				: m_Begin(begin), m_End(end)
+			{}
+
+			const value_type* begin() const
+			{
+				return m_Begin;
+			}
+
+			const value_type* end() const
+			{
+				return m_End;
+			}
+
+			const value_type* data() const
+			{
+				return m_Begin;
+			}
+
+			size_type size() const
+			{
+				return m_End - m_Begin;
+			}
+
+
+		private:
+
+			const value_type*	m_Begin;
+			const value_type*	m_End;
+		};
+
+
+		//	Iterates the cells independent of how they are stored. Use
+		//	VisitCells() for a typed fast path.
+		class const_iterator
+		{
+		public:
+
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = cell_type;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const cell_type*;
+			using reference = cell_type;
+
+
+		public:
+
+			const_iterator(const unsigned char* position, size_t cellSize)
+				: m_Position(position), m_CellSize(cellSize)
+			{}
+
+			cell_type operator*() const
+			{
+				switch (m_CellSize)
+				{
+				case sizeof(uint8_t):
+					return *m_Position;
+
+				case sizeof(uint16_t):
+					return *reinterpret_cast<const uint16_t*>(m_Position);
+
+				default:
+					return *reinterpret_cast<const uint32_t*>(m_Position);
+				}
+			}
+
+			const_iterator& operator++()
+			{
+				m_Position += m_CellSize;
+				return *this;
+			}
+
+			const_iterator operator++(int)
+			{
+				const auto previous(*this);
+				m_Position += m_CellSize;
+				return previous;
+			}
+
+			bool operator==(const const_iterator& other) const
+			{
+				return m_Position == other.m_Position;
+			}
+
+			bool operator!=(const const_iterator& other) const
+			{
+				return m_Position != other.m_Position;
+			}
+
+
+		private:
+
+			const unsigned char*	m_Position;
+			size_t					m_CellSize;
+		};
 
 
 	public:
@@ -32,9 +161,54 @@ namespace KAOS { namespace Tiled
 
 
 		bool Parse(const pugi::xml_node& layer) override;
+		//	Parses the layer attributes but leaves the cell data in the XML
+		//	document. `source` keeps the document alive until the data has
+		//	been decoded.
+		bool ParseStreamed(const pugi::xml_node& layer, source_type source);
+		//	Same as ParseStreamed() except the cells are decoded and kept the
+		//	first time the layer is used.
+		bool ParseDeferred(const pugi::xml_node& layer, source_type source);
+
+		//	Cells are written decoded in their stored cell type. Layers read
+		//	back never refer to an XML document.
+		void Serialize(BinaryWriter& writer) const override;
+		bool Deserialize(BinaryReader& reader) override;
 
 
+		//	For chunked layers the dimensions and origin are those of the
+		//	smallest rectangle holding every chunk. This is the area covered
+		//	by the dense view (VisitRows, VisitCells and the iterators).
 		Size GetDimensions() const;
+		int GetOriginX() const;
+		int GetOriginY() const;
+
+		bool IsChunked() const;
+		//	Returns the chunk containing the cells starting at
+		//	(chunkX * ChunkSize, chunkY * ChunkSize) or nullptr if it is empty.
+		const chunk_type* FindChunk(int chunkX, int chunkY) const;
+		//	Returns the cell at the map position (x, y) without densifying
+		//	chunked layers. Cells outside the layer are empty.
+		cell_type GetCell(int x, int y) const;
+
+		bool VisitRows(const row_visitor_type& visitor) const;
+
+		//	Calls `visitor` with a CellRange of the stored cell type and
+		//	returns its result. Decodes the layer if needed.
+		template<class Visitor_>
+		bool VisitCells(Visitor_&& visitor) const
+		{
+			EnsureDecoded();
+
+			return std::visit([&visitor](const auto& cells) -> bool
+			{
+				using value_type = typename std::decay_t<decltype(cells)>::value_type;
+
+				return visitor(CellRange<value_type>(cells.data(), cells.data() + cells.size()));
+			},
+			m_Data);
+		}
+
+		CellStorage GetCellStorage() const;
 
 		size_type size() const;
 		const_iterator begin() const;
@@ -43,13 +217,39 @@ namespace KAOS { namespace Tiled
 
 	protected:
 
-		bool ParseCSV(Size dimensions, const std::string& data);
+		static uint64_t MakeChunkKey(int chunkX, int chunkY);
+
+		bool DecodeRows(const row_visitor_type& visitor) const;
+		bool DecodeChunkedRows(const row_visitor_type& visitor) const;
+		bool DecodeCSV(const char* data, const Size& dimensions, const row_visitor_type& visitor) const;
+		bool DecodeBase64(
+			const char* data,
+			const std::string& compression,
+			const Size& dimensions,
+			const row_visitor_type& visitor) const;
+		bool DecodeChunks(chunk_collection_type& chunks) const;
+		bool EnsureChunksDecoded() const;
+		bool StoreDecoded() const;
+		void EnsureDecoded() const;
 
 
 	private:
 
-		Size			m_Dimensions;
-		container_type	m_Data;
+		using storage_type = std::variant<std::vector<uint8_t>, std::vector<uint16_t>, container_type>;
+
+		bool Decode(storage_type& data) const;
+
+		Size					m_Dimensions;
+		int						m_OriginX = 0;
+		int						m_OriginY = 0;
+		pugi::xml_node			m_DataNode;
+		mutable source_type		m_Source;
+		mutable storage_type	m_Data;
+		mutable bool			m_IsDecoded = false;
+		bool					m_DecodeOnFirstUse = false;
+		bool					m_IsChunked = false;
+		mutable chunk_collection_type	m_Chunks;
+		mutable bool			m_AreChunksDecoded = false;
 	};
 
 }}